@@ -0,0 +1,11 @@
+BENCHMARK_DIR=$(dirname "$(realpath $0)")/build/benchmark
+SOURCE_DIR="$(pwd)"
+COMMIT=$(git -C ${SOURCE_DIR} rev-parse --short HEAD)
+
+mkdir -p $BENCHMARK_DIR
+BUILD_DIR=$BENCHMARK_DIR/out
+
+cmake -S ${SOURCE_DIR} -B ${BUILD_DIR} -DBENCHMARK=YES -DCMAKE_BUILD_TYPE=Release
+cmake --build ${BUILD_DIR} --target embedded-fft_benchmark
+${BUILD_DIR}/benchmarks/embedded-fft_benchmark --benchmark_out=${BENCHMARK_DIR}/${COMMIT}.json \
+    --benchmark_out_format=json "$@"
@@ -0,0 +1,48 @@
+/**
+ * @file bench_block_floating_point.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the block floating-point FFT against normalizing before the radix-2 butterflies
+ */
+
+#include <algorithm>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+
+void
+BM_NormalizeThenRadix2(benchmark::State& state)
+{
+    const auto size   = static_cast<std::size_t>(state.range(0));
+    const auto input  = bench_utils::make_signal(size);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        fft_utils::normalize(signal);
+        fft_utils::bit_reversal(signal);
+        fft_utils::radix2_stages(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void
+BM_BlockFloatingPoint(benchmark::State& state)
+{
+    const auto size   = static_cast<std::size_t>(state.range(0));
+    const auto input  = bench_utils::make_signal(size);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        benchmark::DoNotOptimize(compute_block_floating_point(signal));
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_NormalizeThenRadix2)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK(BM_BlockFloatingPoint)->RangeMultiplier(4)->Range(64, 65536);
@@ -0,0 +1,74 @@
+/**
+ * @file bench_convolver.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the OverlapSaveConvolver class against a direct-form FIR filter
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "convolver.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+constexpr std::size_t k_stream_size = 1 << 14;
+
+/**
+ * @brief Creates a moving average filter
+ *
+ * @param taps The number of taps
+ * @return The filter coefficients
+ */
+std::vector<Complex>
+make_taps(std::size_t taps)
+{
+    return std::vector<Complex>(taps, Complex(1.0 / taps, 0));
+}
+
+void
+BM_DirectFir(benchmark::State& state)
+{
+    const auto           taps   = make_taps(state.range(0));
+    const auto           stream = make_signal(k_stream_size);
+    std::vector<Complex> output(stream.size());
+    for (auto _ : state) {
+        for (std::size_t n = 0; n < stream.size(); ++n) {
+            Complex accumulator(0, 0);
+            for (std::size_t k = 0; k < taps.size() && k <= n; ++k) {
+                accumulator += taps[k] * stream[n - k];
+            }
+            output[n] = accumulator;
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+template <std::size_t N>
+void
+BM_OverlapSaveConvolver(benchmark::State& state)
+{
+    auto                 convolver = std::make_unique<OverlapSaveConvolver<N>>(make_taps(state.range(0)));
+    const auto           stream    = make_signal(k_stream_size);
+    const auto           block     = convolver->block_size();
+    std::vector<Complex> chunk(block);
+    std::size_t          samples = 0;
+    for (auto _ : state) {
+        convolver->reset();
+        for (std::size_t start = 0; start + block <= stream.size(); start += block) {
+            std::copy_n(stream.begin() + start, block, chunk.begin());
+            convolver->process(chunk);
+            benchmark::DoNotOptimize(chunk.data());
+            samples += block;
+        }
+    }
+    state.SetItemsProcessed(samples);
+}
+
+BENCHMARK(BM_DirectFir)->Arg(256)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_OverlapSaveConvolver, 2048)->Arg(256)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_OverlapSaveConvolver, 4096)->Arg(256)->Arg(1024);
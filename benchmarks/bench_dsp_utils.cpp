@@ -0,0 +1,126 @@
+/**
+ * @file bench_dsp_utils.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the passes of dsp_utils.hpp and the peak search over sizes, containers and numeric types
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "etl/vector.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "testing_utils.hpp"
+
+using namespace fftemb;
+using bench_utils::EtlBuffer;
+using bench_utils::VectorBuffer;
+
+template <typename T, template <typename> class Buffer>
+void
+BM_BitReversal(benchmark::State& state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    Buffer<T>  buffer(size);
+    auto&      signal = buffer.get();
+    const auto input  = bench_utils::make_signal<T>(size);
+    std::copy(input.begin(), input.end(), signal.begin());
+    for (auto _ : state) {
+        fft_utils::bit_reversal(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, size);
+}
+
+// normalize takes its square root and quotients from the numeric_traits of each type
+template <typename T, template <typename> class Buffer>
+void
+BM_Normalize(benchmark::State& state)
+{
+    const auto size  = static_cast<std::size_t>(state.range(0));
+    const auto input = bench_utils::make_signal<T>(size);
+    Buffer<T>  buffer(size);
+    auto&      signal = buffer.get();
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        fft_utils::normalize(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, size);
+}
+
+template <typename T, template <typename> class Buffer>
+void
+BM_ApplyHannWindow(benchmark::State& state)
+{
+    const auto size  = static_cast<std::size_t>(state.range(0));
+    const auto input = bench_utils::make_signal<T>(size);
+    Buffer<T>  buffer(size);
+    auto&      signal = buffer.get();
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        fft_utils::apply_hann_window(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, size);
+}
+
+template <typename T, template <typename> class Buffer>
+void
+BM_ZeroPadding(benchmark::State& state)
+{
+    // one past the previous power of 2, the worst case, padded to the benchmarked size
+    const auto size = static_cast<std::size_t>(state.range(0));
+    Buffer<T>  buffer(size / 2 + 1);
+    auto&      signal = buffer.get();
+    for (auto _ : state) {
+        signal.resize(size / 2 + 1);
+        fft_utils::zero_padding(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, size);
+}
+
+template <typename T, template <typename> class Buffer>
+void
+BM_FindPeaks(benchmark::State& state)
+{
+    const auto size  = static_cast<std::size_t>(state.range(0));
+    const auto input = bench_utils::make_signal<T>(size);
+    Buffer<T>  buffer(size);
+    auto&      spectrum = buffer.get();
+    std::copy(input.begin(), input.end(), spectrum.begin());
+    compute(spectrum);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(test_utils::find_peaks(spectrum, std::chrono::milliseconds(1), 3));
+    }
+    bench_utils::set_point_counters(state, size);
+}
+
+BENCHMARK_TEMPLATE(BM_BitReversal, Complex, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_BitReversal, Complex, EtlBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_BitReversal, std::complex<float>, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_BitReversal, std::complex<double>, VectorBuffer)->Apply(bench_utils::all_sizes);
+
+BENCHMARK_TEMPLATE(BM_Normalize, Complex, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Normalize, Complex, EtlBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Normalize, FastComplex, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Normalize, std::complex<float>, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Normalize, std::complex<double>, VectorBuffer)->Apply(bench_utils::all_sizes);
+
+BENCHMARK_TEMPLATE(BM_ApplyHannWindow, Complex, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_ApplyHannWindow, Complex, EtlBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_ApplyHannWindow, std::complex<float>, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_ApplyHannWindow, std::complex<double>, VectorBuffer)->Apply(bench_utils::all_sizes);
+
+BENCHMARK_TEMPLATE(BM_ZeroPadding, Complex, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_ZeroPadding, Complex, EtlBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_ZeroPadding, std::complex<double>, VectorBuffer)->Apply(bench_utils::all_sizes);
+
+BENCHMARK_TEMPLATE(BM_FindPeaks, Complex, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_FindPeaks, Complex, EtlBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_FindPeaks, std::complex<double>, VectorBuffer)->Apply(bench_utils::all_sizes);
@@ -0,0 +1,40 @@
+/**
+ * @file bench_fft.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the compute function over sizes, containers and numeric types
+ */
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+using bench_utils::EtlBuffer;
+using bench_utils::VectorBuffer;
+
+template <typename T, template <typename> class Buffer>
+void
+BM_Compute(benchmark::State& state)
+{
+    const auto size  = static_cast<std::size_t>(state.range(0));
+    const auto input = bench_utils::make_signal<T>(size);
+    Buffer<T>  buffer(size);
+    auto&      signal = buffer.get();
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_fft_counters(state, size);
+}
+
+BENCHMARK_TEMPLATE(BM_Compute, Complex, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Compute, Complex, EtlBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Compute, std::complex<float>, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Compute, std::complex<float>, EtlBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Compute, std::complex<double>, VectorBuffer)->Apply(bench_utils::all_sizes);
+BENCHMARK_TEMPLATE(BM_Compute, std::complex<double>, EtlBuffer)->Apply(bench_utils::all_sizes);
@@ -0,0 +1,58 @@
+/**
+ * @file bench_fft_batch.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the batched multi-channel FFT against independent compute calls
+ */
+
+#include <algorithm>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft.hpp"
+#include "fft_batch.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+void
+BM_ComputePerChannel(benchmark::State& state)
+{
+    const auto                        size     = static_cast<std::size_t>(state.range(0));
+    const auto                        channels = static_cast<std::size_t>(state.range(1));
+    const auto                        input    = make_signal(size);
+    std::vector<std::vector<Complex>> signals(channels, input);
+    for (auto _ : state) {
+        for (auto& signal : signals) {
+            std::copy(input.begin(), input.end(), signal.begin());
+            compute(signal);
+            benchmark::DoNotOptimize(signal.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * size * channels);
+}
+
+void
+BM_ComputeBatch(benchmark::State& state, BatchLayout layout)
+{
+    const auto           size     = static_cast<std::size_t>(state.range(0));
+    const auto           channels = static_cast<std::size_t>(state.range(1));
+    const auto           signal   = make_signal(size);
+    std::vector<Complex> input(size * channels);
+    for (std::size_t c = 0; c < channels; ++c) {
+        for (std::size_t i = 0; i < size; ++i) {
+            input[layout == BatchLayout::channel_minor ? i * channels + c : c * size + i] = signal[i];
+        }
+    }
+    auto batch = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), batch.begin());
+        compute_batch(batch, channels, layout);
+        benchmark::DoNotOptimize(batch.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * channels);
+}
+
+BENCHMARK(BM_ComputePerChannel)->ArgsProduct({{256, 1024, 4096}, {16, 64}});
+BENCHMARK_CAPTURE(BM_ComputeBatch, channel_minor, BatchLayout::channel_minor)->ArgsProduct({{256, 1024, 4096}, {16, 64}});
+BENCHMARK_CAPTURE(BM_ComputeBatch, channel_major, BatchLayout::channel_major)->ArgsProduct({{256, 1024, 4096}, {16, 64}});
@@ -0,0 +1,66 @@
+/**
+ * @file bench_fft_four_step.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the scaling of the four-step FFT with the number of threads against compute
+ */
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft.hpp"
+#include "fft_four_step.hpp"
+#include "fft_types.hpp"
+#include "thread_pool.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+void
+BM_ComputeLarge(benchmark::State& state)
+{
+    const auto size   = static_cast<std::size_t>(state.range(0));
+    const auto input  = make_signal(size);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void
+BM_FourStep(benchmark::State& state)
+{
+    const auto size    = static_cast<std::size_t>(state.range(0));
+    const auto input   = make_signal(size);
+    auto       signal  = input;
+    auto       scratch = input;
+    ThreadPool pool(state.range(1));
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute_four_step(signal, scratch, pool);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/**
+ * @brief Adds the thread counts from 1 to all the cores, doubling, for each size
+ */
+void
+thread_counts(benchmark::internal::Benchmark* benchmark)
+{
+    const auto cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (const auto size : {1 << 16, 1 << 20, 1 << 22}) {
+        for (int threads = 1; threads < cores; threads *= 2) {
+            benchmark->Args({size, threads});
+        }
+        benchmark->Args({size, cores});
+    }
+}
+
+BENCHMARK(BM_ComputeLarge)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FourStep)->Apply(thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
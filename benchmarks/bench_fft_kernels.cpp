@@ -0,0 +1,32 @@
+/**
+ * @file bench_fft_kernels.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the radix-4 and split-radix kernels against the radix-2 one
+ */
+
+#include <algorithm>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+
+void
+BM_ComputeKernel(benchmark::State& state, FftKernel kernel)
+{
+    const auto size   = static_cast<std::size_t>(state.range(0));
+    const auto input  = bench_utils::make_signal(size);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute(signal, kernel);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK_CAPTURE(BM_ComputeKernel, radix2, FftKernel::radix2)->RangeMultiplier(2)->Range(64, 65536);
+BENCHMARK_CAPTURE(BM_ComputeKernel, radix4, FftKernel::radix4)->RangeMultiplier(2)->Range(64, 65536);
+BENCHMARK_CAPTURE(BM_ComputeKernel, split_radix, FftKernel::split_radix)->RangeMultiplier(2)->Range(64, 65536);
@@ -0,0 +1,50 @@
+/**
+ * @file bench_fft_mixed_radix.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the MixedRadixPlan class against zero padding to the next power of 2
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_mixed_radix.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+void
+BM_ZeroPaddedCompute(benchmark::State& state)
+{
+    const auto           input = make_signal(state.range(0));
+    std::vector<Complex> signal;
+    for (auto _ : state) {
+        signal = input;
+        fft_utils::zero_padding(signal);
+        compute<Complex, std::vector>(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+void
+BM_MixedRadixPlan(benchmark::State& state)
+{
+    const auto           input = make_signal(state.range(0));
+    auto                 plan  = std::make_unique<MixedRadixPlan<>>(input.size());
+    std::vector<Complex> signal(input.size());
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        plan->execute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+}
+
+// 1000 and 1500 are 5-smooth, 1001 = 7 * 11 * 13 and 1009 is prime (Bluestein)
+BENCHMARK(BM_ZeroPaddedCompute)->Arg(1000)->Arg(1001)->Arg(1009)->Arg(1500);
+BENCHMARK(BM_MixedRadixPlan)->Arg(1000)->Arg(1001)->Arg(1009)->Arg(1500);
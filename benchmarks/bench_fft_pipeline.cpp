@@ -0,0 +1,114 @@
+/**
+ * @file bench_fft_pipeline.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Stress benchmark of the FftPipeline class, sustained frames/s and latency percentiles, against the same steps
+ * called synchronously
+ */
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numbers>
+#include <span>
+#include <thread>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "etl/vector.h"
+#include "fft.hpp"
+#include "fft_pipeline.hpp"
+#include "fft_types.hpp"
+#include "ingest.hpp"
+#include "peak_detector.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+
+// the frames submitted by each iteration
+constexpr std::size_t k_burst = 64;
+
+/**
+ * @brief Creates the ADC readings of a frame, a sinusoid over a DC offset
+ *
+ * @param size The number of samples
+ * @return The samples
+ */
+std::vector<int16_t>
+make_frame_readings(std::size_t size)
+{
+    std::vector<int16_t> readings(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        readings[i] = static_cast<int16_t>(std::lround(1000 + 12000 * std::sin(2 * std::numbers::pi * 37 * i / size)));
+    }
+    return readings;
+}
+
+// the steps one after the other on the acquisition thread, as the integrators do today
+template <std::size_t N>
+void
+BM_SynchronousFrames(benchmark::State& state)
+{
+    const std::chrono::nanoseconds period   = std::chrono::microseconds(100);
+    const auto                     readings = make_frame_readings(N);
+    const auto                     samples  = std::span<const int16_t, N>(readings.data(), N);
+    auto                           signal   = std::make_unique<etl::vector<Complex, N>>(N);
+    auto&                          spectrum = static_cast<etl::ivector<Complex>&>(*signal);
+    etl::vector<Peak, 8>           peaks;
+    for (auto _ : state) {
+        for (std::size_t frame = 0; frame < k_burst; ++frame) {
+            fft_utils::ingest(samples, spectrum, fft_utils::k_full_scale_shift<int16_t>, true);
+            fft_utils::apply_window(spectrum, WindowType::hann);
+            compute(spectrum);
+            peaks = find_peaks<8>(static_cast<const etl::ivector<Complex>&>(spectrum), period);
+        }
+        benchmark::DoNotOptimize(peaks.data());
+    }
+    state.SetItemsProcessed(state.iterations() * k_burst);
+    state.counters["frames/s"] = benchmark::Counter(state.iterations() * k_burst, benchmark::Counter::kIsRate);
+}
+
+// the acquisition thread submits as fast as the pool allows, while a consumer thread polls the peaks
+template <std::size_t N>
+void
+BM_PipelineFrames(benchmark::State& state)
+{
+    auto              pipeline = std::make_unique<FftPipeline<N>>();
+    const auto        readings = make_frame_readings(N);
+    const auto        samples  = std::span<const int16_t, N>(readings.data(), N);
+    std::atomic<bool> done{false};
+    std::thread       consumer([&pipeline, &done] {
+        while (!done.load(std::memory_order_acquire)) {
+            if (pipeline->poll([](const auto& frame) { benchmark::DoNotOptimize(frame.peaks.data()); }) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t accepted = 0;
+    for (auto _ : state) {
+        for (std::size_t frame = 0; frame < k_burst; ++frame) {
+            while (!pipeline->submit(samples)) {
+                std::this_thread::yield();
+            }
+        }
+        accepted += k_burst;
+    }
+    while (pipeline->completed() < accepted) {
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    const auto& latency = pipeline->end_to_end_latency();
+    state.SetItemsProcessed(state.iterations() * k_burst);
+    state.counters["frames/s"]   = benchmark::Counter(accepted, benchmark::Counter::kIsRate);
+    state.counters["p50_us"]     = latency.percentile(0.5).count() * 1e-3;
+    state.counters["p99_us"]     = latency.percentile(0.99).count() * 1e-3;
+    state.counters["max_us"]     = latency.max().count() * 1e-3;
+    state.counters["fft_p99_us"] = pipeline->latency(PipelineStage::fft).percentile(0.99).count() * 1e-3;
+}
+
+BENCHMARK_TEMPLATE(BM_SynchronousFrames, 1024)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SynchronousFrames, 4096)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PipelineFrames, 1024)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PipelineFrames, 4096)->UseRealTime();
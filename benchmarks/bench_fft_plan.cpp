@@ -0,0 +1,75 @@
+/**
+ * @file bench_fft_plan.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the FftPlan class and the compile-time compute against the run-time compute function
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft.hpp"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+template <std::size_t N>
+void
+BM_Compute(benchmark::State& state)
+{
+    const auto input  = make_signal(N);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <std::size_t N>
+void
+BM_PlanExecute(benchmark::State& state)
+{
+    const auto plan   = std::make_unique<FftPlan<N>>();
+    const auto input  = make_signal(N);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        plan->execute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <std::size_t N>
+void
+BM_StaticCompute(benchmark::State& state)
+{
+    const auto input  = make_signal(N);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute<N>(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+#define FFTEMB_BENCHMARK_SIZES(bench)   \
+    BENCHMARK_TEMPLATE(bench, 64);      \
+    BENCHMARK_TEMPLATE(bench, 256);     \
+    BENCHMARK_TEMPLATE(bench, 1024);    \
+    BENCHMARK_TEMPLATE(bench, 4096);    \
+    BENCHMARK_TEMPLATE(bench, 16384);   \
+    BENCHMARK_TEMPLATE(bench, 65536)
+
+FFTEMB_BENCHMARK_SIZES(BM_Compute);
+FFTEMB_BENCHMARK_SIZES(BM_PlanExecute);
+BENCHMARK_TEMPLATE(BM_StaticCompute, 64);
+BENCHMARK_TEMPLATE(BM_StaticCompute, 256);
+BENCHMARK_TEMPLATE(BM_StaticCompute, 1024);
+BENCHMARK_TEMPLATE(BM_StaticCompute, 4096);
@@ -0,0 +1,54 @@
+/**
+ * @file bench_fft_pruned.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the PrunedFft class on bands of a few widths against the whole transform of FftPlan
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft_plan.hpp"
+#include "fft_pruned.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+template <std::size_t N>
+void
+BM_WholeSpectrum(benchmark::State& state)
+{
+    const auto plan   = std::make_unique<FftPlan<N>>();
+    const auto input  = make_signal(N);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        plan->execute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+// the band width is the argument, starting at the bin N/8
+template <std::size_t N>
+void
+BM_PrunedBand(benchmark::State& state)
+{
+    const auto pruned = std::make_unique<PrunedFft<N>>(N / 8, state.range(0));
+    const auto input  = make_signal(N);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        pruned->execute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+    state.counters["multiplies"] = static_cast<double>(pruned->multiplies());
+}
+
+BENCHMARK_TEMPLATE(BM_WholeSpectrum, 1024);
+BENCHMARK_TEMPLATE(BM_WholeSpectrum, 16384);
+BENCHMARK_TEMPLATE(BM_PrunedBand, 1024)->RangeMultiplier(4)->Range(4, 1024);
+BENCHMARK_TEMPLATE(BM_PrunedBand, 16384)->RangeMultiplier(8)->Range(8, 16384);
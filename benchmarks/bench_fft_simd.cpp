@@ -0,0 +1,57 @@
+/**
+ * @file bench_fft_simd.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the SIMD engine on raw Q11.20 integers against the CNL radix-2 butterflies
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_simd.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+void
+BM_CnlRadix2(benchmark::State& state)
+{
+    const auto input  = make_signal(state.range(0));
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        fft_utils::bit_reversal(signal);
+        fft_utils::radix2_stages(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void
+BM_SimdRadix2(benchmark::State& state, simd::Isa isa)
+{
+    if (isa > simd::detect_isa()) {
+        state.SkipWithError("instruction set not supported by this CPU");
+        return;
+    }
+    const auto           signal = make_signal(state.range(0));
+    std::vector<int32_t> input(2 * signal.size());
+    std::memcpy(input.data(), signal.data(), input.size() * sizeof(int32_t));
+    auto raw = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), raw.begin());
+        simd::transform_q20(raw.data(), signal.size(), isa);
+        benchmark::DoNotOptimize(raw.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CnlRadix2)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK_CAPTURE(BM_SimdRadix2, scalar, simd::Isa::scalar)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK_CAPTURE(BM_SimdRadix2, sse41, simd::Isa::sse41)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK_CAPTURE(BM_SimdRadix2, avx2, simd::Isa::avx2)->RangeMultiplier(4)->Range(64, 65536);
@@ -0,0 +1,116 @@
+/**
+ * @file bench_fft_stockham.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the Stockham autosort FFT and the tiled bit reversal against the in-place path
+ */
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_types.hpp"
+
+using namespace fftemb;
+
+/**
+ * @brief Registers sizes whose Complex buffers fit in the L1 cache (8 KiB), in the L2 cache (256 KiB) and in DRAM only
+ *
+ * @param benchmark The benchmark
+ */
+void
+cache_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->Arg(1 << 10)->Arg(1 << 15)->Arg(bench_utils::k_max_size);
+}
+
+/**
+ * @brief The previous bit reversal, one scattered swap per element and one loop iteration per bit of each index
+ *
+ * @param[in,out] sequence The sequence of elements
+ */
+template <typename T>
+void
+scalar_bit_reversal(std::vector<T>& sequence)
+{
+    const auto size   = sequence.size();
+    const auto levels = cnl::log2p1(size) - 1;
+    for (std::size_t i = 0; i < size; ++i) {
+        std::size_t j = 0;
+        for (int bit = 0; bit < levels; ++bit) {
+            if (i & (std::size_t{1} << bit)) {
+                j |= std::size_t{1} << (levels - 1 - bit);
+            }
+        }
+        if (j > i) {
+            std::swap(sequence[i], sequence[j]);
+        }
+    }
+}
+
+template <typename T>
+void
+BM_ScalarBitReversal(benchmark::State& state)
+{
+    auto signal = bench_utils::make_signal<T>(state.range(0));
+    for (auto _ : state) {
+        scalar_bit_reversal(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, signal.size());
+}
+
+template <typename T>
+void
+BM_TiledBitReversal(benchmark::State& state)
+{
+    auto signal = bench_utils::make_signal<T>(state.range(0));
+    for (auto _ : state) {
+        fft_utils::bit_reversal(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, signal.size());
+}
+
+template <typename T>
+void
+BM_ComputeInPlace(benchmark::State& state)
+{
+    const auto     input = bench_utils::make_signal<T>(state.range(0));
+    std::vector<T> signal(input.size());
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_fft_counters(state, signal.size());
+}
+
+template <typename T>
+void
+BM_ComputeStockham(benchmark::State& state)
+{
+    const auto     input = bench_utils::make_signal<T>(state.range(0));
+    std::vector<T> signal(input.size());
+    std::vector<T> scratch(input.size());
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute_stockham(signal, scratch);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_fft_counters(state, signal.size());
+}
+
+BENCHMARK_TEMPLATE(BM_ScalarBitReversal, Complex)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(BM_TiledBitReversal, Complex)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(BM_ScalarBitReversal, std::complex<double>)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(BM_TiledBitReversal, std::complex<double>)->Apply(cache_sizes);
+
+BENCHMARK_TEMPLATE(BM_ComputeInPlace, Complex)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(BM_ComputeStockham, Complex)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(BM_ComputeInPlace, std::complex<float>)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(BM_ComputeStockham, std::complex<float>)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(BM_ComputeInPlace, std::complex<double>)->Apply(cache_sizes);
+BENCHMARK_TEMPLATE(BM_ComputeStockham, std::complex<double>)->Apply(cache_sizes);
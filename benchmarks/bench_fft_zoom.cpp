@@ -0,0 +1,60 @@
+/**
+ * @file bench_fft_zoom.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the ZoomFft class against the windowed transform of the whole block
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+#include "fft_zoom.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::microseconds(100);
+
+// the same resolution from a transform of the whole block
+template <std::size_t N>
+void
+BM_WholeBlockFft(benchmark::State& state)
+{
+    const auto plan   = std::make_unique<FftPlan<N>>();
+    const auto window = std::make_unique<std::array<safe_rounding_elastic_integer, N>>();
+    const auto input  = make_signal(N);
+    auto       signal = input;
+    std::copy_n(window_table<>(WindowType::hann, N).begin(), N, window->begin());
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        plan->execute(signal, *window);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <std::size_t M, std::size_t D>
+void
+BM_ZoomFft(benchmark::State& state)
+{
+    // a band of M bins centered a quarter of the sampling rate up
+    const auto           zoom  = std::make_unique<ZoomFft<M, D>>(2500, k_sampling_period);
+    const auto           input = make_signal(M * D);
+    std::vector<Complex> spectrum(M);
+    for (auto _ : state) {
+        zoom->execute(input, spectrum);
+        benchmark::DoNotOptimize(spectrum.data());
+    }
+    state.SetItemsProcessed(state.iterations() * M * D);
+}
+
+BENCHMARK_TEMPLATE(BM_WholeBlockFft, 4096);
+BENCHMARK_TEMPLATE(BM_WholeBlockFft, 65536);
+BENCHMARK_TEMPLATE(BM_ZoomFft, 256, 16);
+BENCHMARK_TEMPLATE(BM_ZoomFft, 1024, 64);
+BENCHMARK_TEMPLATE(BM_ZoomFft, 4096, 16);
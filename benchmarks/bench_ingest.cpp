@@ -0,0 +1,82 @@
+/**
+ * @file bench_ingest.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the fused ingest of integer samples against the conversion through double, window and normalize
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft_types.hpp"
+#include "ingest.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+
+/**
+ * @brief Creates ADC readings of a sine wave on top of a DC offset
+ *
+ * @param size The number of samples
+ * @return The samples
+ */
+std::vector<int16_t>
+make_readings(std::size_t size)
+{
+    std::vector<int16_t> readings(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        readings[i] = static_cast<int16_t>(std::lround(2048 + 12000 * std::sin(2 * std::numbers::pi * 7 * i / size)));
+    }
+    return readings;
+}
+
+// the usual way in: a double conversion per sample, then a window pass and a normalization pass
+void
+BM_ConvertWindowNormalize(benchmark::State& state)
+{
+    const auto           readings = make_readings(state.range(0));
+    std::vector<Complex> signal(readings.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < readings.size(); ++i) {
+            signal[i] = Complex{readings[i] / 32768.0, 0};
+        }
+        fft_utils::normalize(signal);
+        fft_utils::apply_window(signal, WindowType::hann);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, signal.size());
+}
+
+void
+BM_Ingest(benchmark::State& state)
+{
+    const auto           readings = make_readings(state.range(0));
+    std::vector<Complex> signal(readings.size());
+    for (auto _ : state) {
+        fft_utils::ingest(std::span(readings), signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, signal.size());
+}
+
+template <typename T>
+void
+BM_IngestWindowed(benchmark::State& state)
+{
+    const auto     readings = make_readings(state.range(0));
+    std::vector<T> signal(readings.size());
+    for (auto _ : state) {
+        fft_utils::ingest(std::span(readings), signal, WindowType::hann, 15, true);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, signal.size());
+}
+
+BENCHMARK(BM_ConvertWindowNormalize)->RangeMultiplier(4)->Range(16, 16384);
+BENCHMARK(BM_Ingest)->RangeMultiplier(4)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_IngestWindowed, Complex)->RangeMultiplier(4)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_IngestWindowed, std::complex<float>)->RangeMultiplier(4)->Range(16, 16384);
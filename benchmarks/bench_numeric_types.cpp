@@ -0,0 +1,83 @@
+/**
+ * @file bench_numeric_types.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Reports the accuracy and the throughput of compute for each numeric type
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numbers>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "testing_utils.hpp"
+
+using namespace fftemb;
+
+/**
+ * @brief Get the amplitude of the benchmark signal, as large as the range of the type allows for the spectrum
+ *
+ * @tparam T The complex number type
+ * @param size The transform size
+ * @return The amplitude
+ */
+template <typename T>
+double
+amplitude(std::size_t size)
+{
+    using Real = typename T::value_type;
+    if constexpr (numeric_traits<Real>::is_fixed_point) {
+        return std::min(1.0, 0.5 * static_cast<double>(std::numeric_limits<Real>::max()) / size);
+    }
+    else {
+        return 1;
+    }
+}
+
+/**
+ * @brief Benchmarks compute, also reporting the SNR of the spectrum against a double precision DFT
+ *
+ * The signal holds two tones and a low-level third one 60 dB below, whose bin is lost once the noise floor of the
+ * type rises above it.
+ */
+template <typename T>
+void
+BM_ComputeAccuracy(benchmark::State& state)
+{
+    const auto                        size = static_cast<std::size_t>(state.range(0));
+    const auto                        peak = amplitude<T>(size);
+    std::vector<T>                    input(size);
+    std::vector<std::complex<double>> reference(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto phase = 2 * std::numbers::pi * i / size;
+        input[i]     = T(peak * (0.6 * std::sin(37 * phase) + 0.3 * std::cos(101 * phase) + 1e-3 * std::sin(7 * phase)),
+                         0);
+        reference[i] = {static_cast<double>(input[i].real()), 0};
+    }
+    reference = test_utils::reference_dft(reference);
+
+    auto signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute<T, std::vector>(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+
+    std::vector<std::complex<double>> spectrum(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        spectrum[i] = {static_cast<double>(signal[i].real()), static_cast<double>(signal[i].imag())};
+    }
+    bench_utils::set_fft_counters(state, size);
+    state.counters["SNR_dB"] = test_utils::signal_to_noise_ratio(spectrum, reference);
+}
+
+BENCHMARK_TEMPLATE(BM_ComputeAccuracy, std::complex<double>)->RangeMultiplier(4)->Range(256, 4096);
+BENCHMARK_TEMPLATE(BM_ComputeAccuracy, std::complex<float>)->RangeMultiplier(4)->Range(256, 4096);
+BENCHMARK_TEMPLATE(BM_ComputeAccuracy, Complex)->RangeMultiplier(4)->Range(256, 4096);
+BENCHMARK_TEMPLATE(BM_ComputeAccuracy, FastComplex)->RangeMultiplier(4)->Range(256, 4096);
+BENCHMARK_TEMPLATE(BM_ComputeAccuracy, ComplexQ30)->RangeMultiplier(4)->Range(256, 4096);
+BENCHMARK_TEMPLATE(BM_ComputeAccuracy, ComplexQ14)->RangeMultiplier(4)->Range(256, 4096);
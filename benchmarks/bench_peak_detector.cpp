@@ -0,0 +1,61 @@
+/**
+ * @file bench_peak_detector.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the peak detector against the O(N K) peak search of the tests
+ */
+
+#include <chrono>
+#include <complex>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "etl/vector.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "peak_detector.hpp"
+#include "testing_utils.hpp"
+
+using namespace fftemb;
+
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::milliseconds(1);
+
+/**
+ * @brief Creates the spectrum of a sine wave
+ *
+ * @param size The transform size
+ * @return The spectrum
+ */
+std::vector<Complex>
+make_spectrum(std::size_t size)
+{
+    auto spectrum = bench_utils::make_signal(size);
+    compute(spectrum);
+    return spectrum;
+}
+
+template <std::size_t K>
+void
+BM_TestUtilsFindPeaks(benchmark::State& state)
+{
+    auto spectrum = make_spectrum(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(test_utils::find_peaks(spectrum, k_sampling_period, K));
+    }
+    bench_utils::set_point_counters(state, spectrum.size());
+}
+
+template <std::size_t K>
+void
+BM_FindPeaks(benchmark::State& state)
+{
+    const auto spectrum = make_spectrum(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(find_peaks<K>(spectrum, k_sampling_period));
+    }
+    bench_utils::set_point_counters(state, spectrum.size());
+}
+
+BENCHMARK_TEMPLATE(BM_TestUtilsFindPeaks, 3)->RangeMultiplier(8)->Range(1024, 65536);
+BENCHMARK_TEMPLATE(BM_TestUtilsFindPeaks, 16)->RangeMultiplier(8)->Range(1024, 65536);
+BENCHMARK_TEMPLATE(BM_FindPeaks, 3)->RangeMultiplier(8)->Range(1024, 65536);
+BENCHMARK_TEMPLATE(BM_FindPeaks, 16)->RangeMultiplier(8)->Range(1024, 65536);
@@ -0,0 +1,50 @@
+/**
+ * @file bench_rfft.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the real-input FFT against the complex FFT of the same real signal
+ */
+
+#include <algorithm>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "rfft.hpp"
+
+using namespace fftemb;
+
+void
+BM_ComplexFFTOfRealSignal(benchmark::State& state)
+{
+    const auto size   = static_cast<std::size_t>(state.range(0));
+    const auto input  = bench_utils::make_signal(size);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute(signal, FftKernel::split_radix);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+void
+BM_Rfft(benchmark::State& state)
+{
+    const auto                                 size  = static_cast<std::size_t>(state.range(0));
+    const auto                                 input = bench_utils::make_signal(size);
+    std::vector<safe_rounding_elastic_integer> samples;
+    std::vector<Complex>                       spectrum;
+    for (const auto& sample : input) {
+        samples.push_back(sample.real());
+    }
+    spectrum.reserve(size / 2 + 1);
+    for (auto _ : state) {
+        rfft(samples, spectrum);
+        benchmark::DoNotOptimize(spectrum.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+BENCHMARK(BM_ComplexFFTOfRealSignal)->RangeMultiplier(4)->Range(64, 65536);
+BENCHMARK(BM_Rfft)->RangeMultiplier(4)->Range(64, 65536);
@@ -0,0 +1,107 @@
+/**
+ * @file bench_spectrum.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the batch spectrum kernels against the magnitude of each bin, and against the FFT itself
+ */
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "spectrum.hpp"
+
+using namespace fftemb;
+
+/**
+ * @brief Creates the spectrum of a sine wave
+ *
+ * @param size The transform size
+ * @return The spectrum
+ */
+template <typename T = Complex>
+std::vector<T>
+make_spectrum(std::size_t size)
+{
+    auto spectrum = bench_utils::make_signal<T>(size);
+    compute(spectrum);
+    return spectrum;
+}
+
+template <typename T>
+void
+BM_Abs(benchmark::State& state)
+{
+    const auto                                 spectrum = make_spectrum<T>(state.range(0));
+    std::vector<decltype(fft_utils::abs(T{}))> magnitude(spectrum.size());
+    for (auto _ : state) {
+        std::transform(spectrum.begin(), spectrum.end(), magnitude.begin(), [](const T& bin) {
+            return fft_utils::abs(bin);
+        });
+        benchmark::DoNotOptimize(magnitude.data());
+    }
+    bench_utils::set_point_counters(state, spectrum.size());
+}
+
+template <typename T>
+void
+BM_PowerSpectrum(benchmark::State& state)
+{
+    const auto         spectrum = make_spectrum<T>(state.range(0));
+    std::vector<float> power(spectrum.size());
+    for (auto _ : state) {
+        fft_utils::power_spectrum(spectrum, power);
+        benchmark::DoNotOptimize(power.data());
+    }
+    bench_utils::set_point_counters(state, spectrum.size());
+}
+
+template <typename T>
+void
+BM_MagnitudeSpectrumApprox(benchmark::State& state)
+{
+    const auto         spectrum = make_spectrum<T>(state.range(0));
+    std::vector<float> magnitude(spectrum.size());
+    for (auto _ : state) {
+        fft_utils::magnitude_spectrum_approx(spectrum, magnitude);
+        benchmark::DoNotOptimize(magnitude.data());
+    }
+    bench_utils::set_point_counters(state, spectrum.size());
+}
+
+template <typename T>
+void
+BM_DbSpectrum(benchmark::State& state)
+{
+    const auto         spectrum = make_spectrum<T>(state.range(0));
+    std::vector<float> db(spectrum.size());
+    for (auto _ : state) {
+        fft_utils::db_spectrum(spectrum, db);
+        benchmark::DoNotOptimize(db.data());
+    }
+    bench_utils::set_point_counters(state, spectrum.size());
+}
+
+// the transform alone, the reference of the post-processing cost at small sizes
+void
+BM_ComputeSpectrum(benchmark::State& state)
+{
+    const auto           input = bench_utils::make_signal(state.range(0));
+    std::vector<Complex> signal(input.size());
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        compute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    bench_utils::set_point_counters(state, signal.size());
+}
+
+BENCHMARK_TEMPLATE(BM_Abs, Complex)->RangeMultiplier(4)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_PowerSpectrum, Complex)->RangeMultiplier(4)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_PowerSpectrum, std::complex<float>)->RangeMultiplier(4)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_MagnitudeSpectrumApprox, Complex)->RangeMultiplier(4)->Range(16, 16384);
+BENCHMARK_TEMPLATE(BM_DbSpectrum, Complex)->RangeMultiplier(4)->Range(16, 16384);
+BENCHMARK(BM_ComputeSpectrum)->RangeMultiplier(4)->Range(16, 16384);
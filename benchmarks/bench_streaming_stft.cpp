@@ -0,0 +1,62 @@
+/**
+ * @file bench_streaming_stft.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the StreamingStft class against copying each overlapping frame before the transform
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+#include "streaming_stft.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+constexpr std::size_t k_chunk_size = 64;
+
+template <std::size_t N>
+void
+BM_CopyFramesThenPlan(benchmark::State& state)
+{
+    const auto           plan   = std::make_unique<FftPlan<N>>();
+    const auto           hop    = N / 4;
+    const auto           stream = make_signal(16 * N);
+    std::vector<Complex> frame(N);
+    for (auto _ : state) {
+        for (std::size_t start = 0; start + N <= stream.size(); start += hop) {
+            std::copy_n(stream.begin() + start, N, frame.begin());
+            fft_utils::apply_window(frame, WindowType::hann);
+            plan->execute(frame);
+            benchmark::DoNotOptimize(frame.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+template <std::size_t N>
+void
+BM_StreamingStft(benchmark::State& state)
+{
+    auto                 stft   = std::make_unique<StreamingStft<N>>(N / 4);
+    const auto           stream = make_signal(16 * N);
+    std::vector<Complex> chunk(k_chunk_size);
+    for (auto _ : state) {
+        stft->reset();
+        for (std::size_t start = 0; start < stream.size(); start += k_chunk_size) {
+            std::copy_n(stream.begin() + start, k_chunk_size, chunk.begin());
+            stft->push(chunk, [](const auto& spectrum) { benchmark::DoNotOptimize(spectrum.data()); });
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+BENCHMARK_TEMPLATE(BM_CopyFramesThenPlan, 256);
+BENCHMARK_TEMPLATE(BM_CopyFramesThenPlan, 4096);
+BENCHMARK_TEMPLATE(BM_StreamingStft, 256);
+BENCHMARK_TEMPLATE(BM_StreamingStft, 4096);
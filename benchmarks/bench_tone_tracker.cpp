@@ -0,0 +1,88 @@
+/**
+ * @file bench_tone_tracker.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the Goertzel and sliding DFT trackers against a whole transform of each block
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "tone_tracker.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+
+constexpr std::size_t              k_block_size      = 1024;
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::microseconds(125);
+// keeps the Goertzel states, about |X| / sin(ω), within the range of Complex
+constexpr double k_input_scale = 1.0 / 32;
+
+/**
+ * @brief Spreads K frequencies over the positive half of the spectrum
+ *
+ * @return The frequencies, in Hz
+ */
+template <std::size_t K>
+std::array<double, K>
+make_frequencies()
+{
+    std::array<double, K> frequencies;
+    for (std::size_t k = 0; k < K; ++k) {
+        frequencies[k] = 60.0 * (k + 1);
+    }
+    return frequencies;
+}
+
+// the whole spectrum of each block, the reference of the trackers
+void
+BM_ComputeBlock(benchmark::State& state)
+{
+    const auto           input = bench_utils::make_signal(k_block_size);
+    std::vector<Complex> block(k_block_size);
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), block.begin());
+        fft_utils::apply_window(block, WindowType::hann);
+        compute(block);
+        benchmark::DoNotOptimize(block.data());
+    }
+    bench_utils::set_point_counters(state, k_block_size);
+}
+
+template <std::size_t K>
+void
+BM_Goertzel(benchmark::State& state)
+{
+    const auto input    = bench_utils::make_signal(k_block_size);
+    auto       goertzel = std::make_unique<Goertzel<k_block_size, K>>(
+        make_frequencies<K>(), k_sampling_period, WindowType::hann, k_input_scale);
+    for (auto _ : state) {
+        goertzel->push(input, [](const auto& bins) { benchmark::DoNotOptimize(bins.data()); });
+    }
+    bench_utils::set_point_counters(state, k_block_size);
+}
+
+template <std::size_t K>
+void
+BM_SlidingDft(benchmark::State& state)
+{
+    const auto input   = bench_utils::make_signal(k_block_size);
+    auto       sliding = std::make_unique<SlidingDft<k_block_size, K>>(
+        make_frequencies<K>(), k_sampling_period, WindowType::hann, k_input_scale);
+    for (auto _ : state) {
+        sliding->push(input);
+        benchmark::DoNotOptimize(sliding->bin(0));
+    }
+    bench_utils::set_point_counters(state, k_block_size);
+}
+
+BENCHMARK(BM_ComputeBlock);
+BENCHMARK_TEMPLATE(BM_Goertzel, 2);
+BENCHMARK_TEMPLATE(BM_Goertzel, 8);
+BENCHMARK_TEMPLATE(BM_SlidingDft, 2);
+BENCHMARK_TEMPLATE(BM_SlidingDft, 8);
@@ -0,0 +1,131 @@
+/**
+ * @file bench_utils.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Declares helpers shared by the benchmarks
+ */
+
+#ifndef H_BENCH_UTILS_HPP
+#define H_BENCH_UTILS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "etl/vector.h"
+#include "fft_types.hpp"
+
+namespace fftemb::bench_utils
+{
+/**
+ * @brief Creates a sine wave whose spectrum fits in the fixed-point range for any benchmarked size
+ *
+ * @param size The number of samples
+ * @return The signal
+ */
+template <typename T = Complex>
+std::vector<T>
+make_signal(std::size_t size)
+{
+    const auto     amplitude = std::min(1.0, 1024.0 / size);
+    std::vector<T> signal(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        signal[i] = T(amplitude * std::sin(2 * std::numbers::pi * 7 * i / size), 0);
+    }
+    return signal;
+}
+
+/// @brief The largest signal size of the benchmarks, and the capacity of their etl::vector buffers
+inline constexpr std::size_t k_max_size = std::size_t{1} << 20;
+
+/**
+ * @brief Registers the sizes of the hot path benchmarks, the powers of 4 from 16 to k_max_size
+ *
+ * @param benchmark The benchmark
+ */
+inline void
+all_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->RangeMultiplier(4)->Range(16, k_max_size);
+}
+
+/**
+ * @brief Holds a signal of run-time size in a std::vector
+ *
+ * @tparam T The complex number type
+ */
+template <typename T>
+class VectorBuffer
+{
+public:
+    explicit VectorBuffer(std::size_t size) : m_signal(size) {}
+
+    std::vector<T>&
+    get()
+    {
+        return m_signal;
+    }
+
+private:
+    std::vector<T> m_signal;
+};
+
+/**
+ * @brief Holds a signal of run-time size in an etl::vector of k_max_size capacity, allocated on the heap
+ *
+ * @tparam T The complex number type
+ */
+template <typename T>
+class EtlBuffer
+{
+public:
+    explicit EtlBuffer(std::size_t size) : m_signal(std::make_unique<etl::vector<T, k_max_size>>(size)) {}
+
+    etl::ivector<T>&
+    get()
+    {
+        return *m_signal;
+    }
+
+private:
+    std::unique_ptr<etl::vector<T, k_max_size>> m_signal;
+};
+
+/**
+ * @brief Reports the time per point of a pass over a signal
+ *
+ * @param state The benchmark state
+ * @param size The number of points processed per iteration
+ */
+inline void
+set_point_counters(benchmark::State& state, std::size_t size)
+{
+    state.SetItemsProcessed(state.iterations() * size);
+    state.counters["ns/point"] = benchmark::Counter(
+        1e-9 * size, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/**
+ * @brief Reports the time per point, the MFLOPS equivalent and the cycles per butterfly of a radix-2 FFT
+ *
+ * The MFLOPS equivalent counts 5 N log2(N) operations per transform, the usual figure for comparing FFTs of
+ * different algorithms, and the cycles come from the nominal CPU frequency, as the rest of Google Benchmark's.
+ *
+ * @param state The benchmark state
+ * @param size The transform size
+ */
+inline void
+set_fft_counters(benchmark::State& state, std::size_t size)
+{
+    const auto stages      = std::log2(static_cast<double>(size));
+    const auto butterflies = size / 2 * stages;
+    set_point_counters(state, size);
+    state.counters["MFLOPS"] = benchmark::Counter(5e-6 * size * stages, benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["cycles/butterfly"]
+        = benchmark::Counter(butterflies / benchmark::CPUInfo::Get().cycles_per_second,
+                             benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+}  // namespace fftemb::bench_utils
+
+#endif  // H_BENCH_UTILS_HPP
@@ -0,0 +1,70 @@
+/**
+ * @file bench_welch_psd.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the WelchPsd class against accumulating the magnitude of each bin in double
+ */
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft_types.hpp"
+#include "streaming_stft.hpp"
+#include "welch_psd.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+constexpr std::size_t k_chunk_size = 64;
+
+// the usual caller code: a square root per bin from fft_utils::abs, squared again into a double accumulator
+template <std::size_t N>
+void
+BM_StftAbsAccumulate(benchmark::State& state)
+{
+    auto                 stft   = std::make_unique<StreamingStft<N>>(N / 2);
+    auto                 power  = std::make_unique<std::array<double, N>>();
+    const auto           stream = make_signal(64 * N);
+    std::vector<Complex> chunk(k_chunk_size);
+    for (auto _ : state) {
+        stft->reset();
+        power->fill(0);
+        for (std::size_t start = 0; start < stream.size(); start += k_chunk_size) {
+            std::copy_n(stream.begin() + start, k_chunk_size, chunk.begin());
+            stft->push(chunk, [&power](const auto& spectrum) {
+                for (std::size_t k = 0; k < N; ++k) {
+                    const auto magnitude = static_cast<double>(fft_utils::abs(spectrum[k]));
+                    (*power)[k] += magnitude * magnitude;
+                }
+            });
+        }
+        benchmark::DoNotOptimize(power->data());
+    }
+    state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+template <std::size_t N>
+void
+BM_WelchPsd(benchmark::State& state)
+{
+    auto                 psd    = std::make_unique<WelchPsd<N>>(N / 2);
+    const auto           stream = make_signal(64 * N);
+    std::vector<Complex> chunk(k_chunk_size);
+    for (auto _ : state) {
+        psd->reset();
+        for (std::size_t start = 0; start < stream.size(); start += k_chunk_size) {
+            std::copy_n(stream.begin() + start, k_chunk_size, chunk.begin());
+            psd->push(chunk);
+        }
+        benchmark::DoNotOptimize(psd->frames());
+    }
+    state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+BENCHMARK_TEMPLATE(BM_StftAbsAccumulate, 256);
+BENCHMARK_TEMPLATE(BM_StftAbsAccumulate, 4096);
+BENCHMARK_TEMPLATE(BM_WelchPsd, 256);
+BENCHMARK_TEMPLATE(BM_WelchPsd, 4096);
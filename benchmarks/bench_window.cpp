@@ -0,0 +1,57 @@
+/**
+ * @file bench_window.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Benchmarks the window pass separate from and fused with the bit reversal of FftPlan
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "bench_utils.hpp"
+#include "benchmark/benchmark.h"
+#include "dsp_utils.hpp"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+using bench_utils::make_signal;
+
+template <std::size_t N>
+void
+BM_WindowThenPlan(benchmark::State& state)
+{
+    const auto plan   = std::make_unique<FftPlan<N>>();
+    const auto input  = make_signal(N);
+    auto       signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        fft_utils::apply_window(signal, WindowType::blackman_harris);
+        plan->execute(signal);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <std::size_t N>
+void
+BM_FusedWindowPlan(benchmark::State& state)
+{
+    const auto  plan   = std::make_unique<FftPlan<N>>();
+    const auto& window = window_table<WindowType::blackman_harris, N>();
+    const auto  input  = make_signal(N);
+    auto        signal = input;
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), signal.begin());
+        plan->execute(signal, window);
+        benchmark::DoNotOptimize(signal.data());
+    }
+    state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK_TEMPLATE(BM_WindowThenPlan, 256);
+BENCHMARK_TEMPLATE(BM_WindowThenPlan, 4096);
+BENCHMARK_TEMPLATE(BM_WindowThenPlan, 65536);
+BENCHMARK_TEMPLATE(BM_FusedWindowPlan, 256);
+BENCHMARK_TEMPLATE(BM_FusedWindowPlan, 4096);
+BENCHMARK_TEMPLATE(BM_FusedWindowPlan, 65536);
@@ -0,0 +1,151 @@
+/**
+ * @file convolver.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the OverlapSaveConvolver class
+ */
+
+#ifndef H_CONVOLVER_HPP
+#define H_CONVOLVER_HPP
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <cstddef>
+#include "etl/vector.h"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+
+namespace fftemb
+{
+/**
+ * @brief FIR filter of a continuous stream by fast convolution, with the overlap-save method
+ *
+ * Each block of N - M + 1 new samples is joined to the last M - 1 samples of the stream, transformed, multiplied by
+ * the cached spectrum of the M filter taps and transformed back; the first M - 1 outputs, wrapped around by the
+ * circular convolution, are discarded. The cost per sample is O(log N), instead of O(M) for the direct form.
+ *
+ * In fixed point, the frame is transformed with the halving inverse butterflies, so its spectrum is computed already
+ * divided by N and never grows. Since the inverse transform of conj(x) is conj(X) / N, the frame and the product are
+ * conjugated, which turns the last transform into the unscaled forward one. The output thus keeps the magnitude of
+ * the filtered signal at every stage.
+ *
+ * @tparam N The transform size (must be a power of 2)
+ * @tparam T The complex number type
+ */
+template <std::size_t N, typename T = Complex>
+class OverlapSaveConvolver
+{
+public:
+    /**
+     * @brief Construct a new convolver, caching the spectrum of the filter
+     *
+     * @param taps The filter coefficients, from 1 to N of them
+     */
+    template <template <class...> class Container>
+    explicit OverlapSaveConvolver(const Container<T>& taps);
+
+    /**
+     * @brief Filters the next block of the stream in place
+     *
+     * @param[in,out] block The block_size() new samples, replaced by the filter output
+     */
+    template <template <class...> class Container>
+    void
+    process(Container<T>& block);
+
+    /**
+     * @brief Clears the history, as if the stream was preceded by zeros
+     */
+    void
+    reset();
+
+    /**
+     * @brief Get the number of samples of each block
+     *
+     * @return N - M + 1, for M filter taps
+     */
+    std::size_t
+    block_size() const
+    {
+        return N - m_history_size;
+    }
+
+    /**
+     * @brief Get the transform size
+     *
+     * @return The number of samples of each transformed frame
+     */
+    static constexpr std::size_t
+    size()
+    {
+        return N;
+    }
+
+private:
+    /// @brief The plan of the transforms
+    FftPlan<N, T> m_plan;
+    /// @brief The conjugate of the spectrum of the zero-padded taps
+    std::array<T, N> m_filter;
+    /// @brief The last M - 1 samples of the stream, the oldest one first
+    std::array<T, N> m_history;
+    /// @brief The work buffer of the frame transform
+    etl::vector<T, N> m_frame;
+    /// @brief The work buffer of the product transform
+    etl::vector<T, N> m_product;
+    /// @brief The number of samples kept between blocks, M - 1
+    std::size_t m_history_size;
+};
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+OverlapSaveConvolver<N, T>::OverlapSaveConvolver(const Container<T>& taps)
+  : m_frame(N, T(0, 0)), m_product(N), m_history_size(taps.size() - 1)
+{
+    std::copy(taps.begin(), taps.end(), m_frame.begin());
+    m_plan.execute(m_frame);
+    for (std::size_t k = 0; k < N; ++k) {
+        m_filter[k] = std::conj(m_frame[k]);
+    }
+    m_history.fill(T(0, 0));
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+void
+OverlapSaveConvolver<N, T>::process(Container<T>& block)
+{
+    const auto& bit_reversed = m_plan.bit_reversed_indices();
+    const auto  count        = block_size();
+
+    for (std::size_t i = 0; i < m_history_size; ++i) {
+        m_frame[bit_reversed[i]] = std::conj(m_history[i]);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        m_frame[bit_reversed[m_history_size + i]] = std::conj(block[i]);
+    }
+    // the last M - 1 samples of the frame, read ahead of the ones written
+    for (std::size_t i = 0; i < m_history_size; ++i) {
+        m_history[i] = count + i < m_history_size ? m_history[count + i] : block[count + i - m_history_size];
+    }
+
+    m_plan.inverse_butterflies(m_frame);
+    for (std::size_t k = 0; k < N; ++k) {
+        m_product[bit_reversed[k]] = m_frame[k] * m_filter[k];
+    }
+    m_plan.butterflies(m_product);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        block[i] = std::conj(m_product[m_history_size + i]);
+    }
+}
+
+template <std::size_t N, typename T>
+void
+OverlapSaveConvolver<N, T>::reset()
+{
+    m_history.fill(T(0, 0));
+}
+
+}  // namespace fftemb
+
+#endif  // H_CONVOLVER_HPP
@@ -11,37 +11,39 @@
 #include <cmath>
 #include <complex>
 #include <numbers>
+#include <span>
 #include <vector>
 #include "etl/vector.h"
+#include "fft_tables.hpp"
 #include "fft_types.hpp"
+#include "instrumentation.hpp"
+#include "window.hpp"
 
 namespace fftemb::fft_utils
 {
 /**
  * @brief Apply the bit reversal permutation to the container
  *
- * @param[in,out] sequence The sequence of elements
+ * @param[in,out] sequence The sequence of elements (its size must be a power of 2)
  */
 template <typename T = Complex, template <class...> class Container = etl::ivector>
 void
 bit_reversal(Container<T>& sequence)
 {
-    auto sequence_size = sequence.size();
-    auto levels        = cnl::log2p1(sequence_size) - 1;
-
-    for (int i = 0; i < sequence_size; ++i) {
-        int j = 0;
-        for (int bit = 0; bit < levels; ++bit) {
-            if (i & (1 << bit)) {
-                j |= (1 << (levels - 1 - bit));
-            }
-        }
-        if (j > i) {
-            std::swap(sequence[i], sequence[j]);
-        }
-    }
+    permute_bit_reversed(sequence.data(), sequence.size());
 }
 
+/**
+ * @brief Apply the bit reversal permutation in place, on memory owned by the caller
+ *
+ * @param[in,out] sequence The sequence of elements (its size must be a power of 2)
+ */
+template <typename T, std::size_t Extent>
+void
+bit_reversal(std::span<T, Extent> sequence)
+{
+    permute_bit_reversed(sequence.data(), sequence.size());
+}
 
 /**
  * @brief Append zeros to the sequence until the next power of 2, if applicable
@@ -63,9 +65,24 @@ zero_padding(Container<T>& sequence)
     }
 }
 
+/**
+ * @brief Calculates the squared magnitude of a complex number, without any square root
+ *
+ * @param complex The complex number
+ * @return The squared magnitude, in the widened type of the products
+ */
+template <typename T>
+auto
+squared_magnitude(const T& complex)
+{
+    return complex.real() * complex.real() + complex.imag() * complex.imag();
+}
+
 /**
  * @brief Normalize a sequence of complex numbers
  *
+ * The largest element is found by its squared magnitude, so a single square root is taken for the whole sequence.
+ *
  * @param[in,out] sequence The sequence of elements
  * @return The longest norm of the sequence
  */
@@ -73,18 +90,38 @@ template <typename T = Complex, template <class...> class Container = etl::ivect
 auto
 normalize(Container<T>& sequence)
 {
-    auto max_it        = std::max_element(sequence.begin(), sequence.end(), [](const T& a, const T& b) {
-        return abs(a) < abs(b);
-    });
-    auto max_amplitude = cnl::sqrt(max_it->real() * max_it->real() + max_it->imag() * max_it->imag());
+    FFTEMB_PROBE(normalize);
+    auto max_norm = squared_magnitude(*sequence.begin());
+    for (auto it = sequence.begin() + 1; it != sequence.end(); ++it) {
+        const auto norm = squared_magnitude(*it);
+        if (norm > max_norm) {
+            max_norm = norm;
+        }
+    }
+    using Traits       = numeric_traits<typename T::value_type>;
+    auto max_amplitude = Traits::sqrt(max_norm);
     std::transform(sequence.begin(), sequence.end(), sequence.begin(), [max_amplitude](auto& bin) {
-        return T(cnl::quotient(bin.real(), max_amplitude), cnl::quotient(bin.imag(), max_amplitude));
+        return T(Traits::quotient(bin.real(), max_amplitude), Traits::quotient(bin.imag(), max_amplitude));
     });
     return max_amplitude;
 }
 
 /**
- * @brief Sequence to mulitply by the Hann window
+ * @brief Normalize a sequence of complex numbers in place, on memory owned by the caller
+ *
+ * @param[in,out] sequence The sequence of elements
+ * @return The longest norm of the sequence
+ */
+template <typename T, std::size_t Extent>
+auto
+normalize(std::span<T, Extent> sequence)
+{
+    Span<T> view(sequence);
+    return normalize<T, Span>(view);
+}
+
+/**
+ * @brief Sequence to mulitply by the Hann window, corrected by its coherent gain
  *
  * @param[in,out] sequence The sequence of elements
  */
@@ -92,16 +129,24 @@ template <typename T = Complex, template <class...> class Container = etl::ivect
 void
 apply_hann_window(Container<T>& sequence)
 {
-    T    correction_fator{2, 0};
-    auto sequence_size = sequence.size();
-    for (int i = 0; i <= sequence_size; ++i) {
-        T hanning_bin = {0.5 - 0.5 * std::cos(2 * std::numbers::pi * i / sequence_size), 0};
-        sequence[i]   = sequence[i] * hanning_bin * correction_fator;
-    }
+    apply_window<T, Container>(sequence, WindowType::hann);
+}
+
+/**
+ * @brief Multiply a sequence by the Hann window in place, on memory owned by the caller
+ *
+ * @param[in,out] sequence The sequence of elements
+ */
+template <typename T, std::size_t Extent>
+void
+apply_hann_window(std::span<T, Extent> sequence)
+{
+    Span<T> view(sequence);
+    apply_hann_window<T, Span>(view);
 }
 
 /**
- * @brief Calculates the norm of a complex number using CNL's sqrt
+ * @brief Calculates the norm of a complex number using the square root of its numeric traits
  *
  * @param complex The complex number
  * @return The norm
@@ -110,7 +155,8 @@ template <typename T = Complex, template <class...> class Container = etl::ivect
 auto
 abs(T complex)
 {
-    return cnl::sqrt(complex.real() * complex.real() + complex.imag() * complex.imag());
+    return numeric_traits<typename T::value_type>::sqrt(complex.real() * complex.real()
+                                                        + complex.imag() * complex.imag());
 }
 
 }  // namespace fftemb::fft_utils
@@ -7,33 +7,55 @@
 #ifndef H_FFT_HPP
 #define H_FFT_HPP
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
+#include <limits>
 #include <memory>
 #include <numbers>
+#include <span>
 #include "dsp_utils.hpp"
 #include "etl/vector.h"
 #include "fft.hpp"
+#include "fft_mixed_radix.hpp"
+#include "fft_simd.hpp"
+#include "fft_tables.hpp"
 #include "fft_types.hpp"
+#include "instrumentation.hpp"
 
 namespace fftemb
 {
 /**
- * @brief Computes the in-place FFT transform
+ * @brief The butterfly kernels available to the FFT
  *
- * @param[in,out] signal The signal to be transformed
+ * The radix-2 kernel runs Complex and FastComplex signals on their raw Q11.20 integers, through the SIMD engine,
+ * which rounds half away from zero and saturates out of range values. The other kernels use the arithmetic of the
+ * type itself: Complex rounds and traps on overflow, FastComplex truncates and wraps around.
+ */
+enum class FftKernel
+{
+    /// @brief Radix-2 decimation in time
+    radix2,
+    /// @brief Radix-4 decimation in time, with a leading radix-2 stage for odd powers of 2
+    radix4,
+    /// @brief Split-radix decimation in frequency
+    split_radix
+};
+
+namespace fft_utils
+{
+/**
+ * @brief Computes the radix-2 butterfly stages of a bit reversed signal
+ *
+ * @param[in,out] signal The bit reversed signal
  */
 template <typename T = Complex, template <class...> class Container = etl::ivector>
 void
-compute(Container<T>& signal)
+radix2_stages(Container<T>& signal)
 {
-    if (!cnl::ispow2(signal.size())) {
-        fft_utils::zero_padding(signal);
-    }
-    fft_utils::bit_reversal(signal);
-
-    int n = signal.size();
-    for (uint32_t len = 2; len <= n; len <<= 1) {
+    const std::size_t n = signal.size();
+    for (uint32_t len = 2, stage = 0; len <= n; len <<= 1, ++stage) {
+        FFTEMB_STAGE_BEGIN(start);
         auto angle = 2 * std::numbers::pi / len;
         T    wlen(std::cos(angle), std::sin(angle));
 
@@ -47,6 +69,506 @@ compute(Container<T>& signal)
                 w *= wlen;
             }
         }
+        FFTEMB_STAGE_END(start, stage, signal.data(), signal.size());
+    }
+}
+
+/**
+ * @brief Computes the radix-4 butterfly stages of a bit reversed signal
+ *
+ * Each radix-4 butterfly merges two radix-2 stages, using 3 complex multiplies instead of 4. Since the input is
+ * in binary (not base 4) bit reversed order, the quarters of every block hold the sub-transforms of the samples
+ * congruent to 0, 2, 1 and 3 (mod 4), in that order. Each radix-4 stage is recorded as the second of the two radix-2
+ * stages it merges, as the fused stages of the SIMD engine.
+ *
+ * @param[in,out] signal The bit reversed signal
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+radix4_stages(Container<T>& signal)
+{
+    const uint32_t n       = signal.size();
+    uint32_t       quarter = 1;
+
+    // odd powers of 2 start with a twiddle-free radix-2 stage
+    if ((cnl::log2p1(n) - 1) % 2 == 1) {
+        FFTEMB_STAGE_BEGIN(start);
+        for (uint32_t i = 0; i < n; i += 2) {
+            auto u        = signal[i];
+            auto v        = signal[i + 1];
+            signal[i]     = u + v;
+            signal[i + 1] = u - v;
+        }
+        FFTEMB_STAGE_END(start, 0, signal.data(), signal.size());
+        quarter = 2;
+    }
+
+    for (; quarter * 4 <= n; quarter *= 4) {
+        FFTEMB_STAGE_BEGIN(start);
+        const auto           len  = quarter * 4;
+        const auto           step = std::polar(1.0, 2 * std::numbers::pi / len);
+        std::complex<double> w(1);
+        for (uint32_t k = 0; k < quarter; ++k, w *= step) {
+            const auto w_squared = w * w;
+            const T    w1(w.real(), w.imag());
+            const T    w2(w_squared.real(), w_squared.imag());
+            const T    w3((w_squared * w).real(), (w_squared * w).imag());
+
+            for (uint32_t i = k; i < n; i += len) {
+                auto t0 = signal[i];
+                auto t2 = signal[i + quarter];
+                auto t1 = signal[i + 2 * quarter];
+                auto t3 = signal[i + 3 * quarter];
+                if (k != 0) {
+                    t1 = w1 * t1;
+                    t2 = w2 * t2;
+                    t3 = w3 * t3;
+                }
+                const auto even_sum   = t0 + t2;
+                const auto even_diff  = t0 - t2;
+                const auto odd_sum    = t1 + t3;
+                const auto odd_diff   = t1 - t3;
+                const auto i_odd_diff = T(-odd_diff.imag(), odd_diff.real());
+
+                signal[i]               = even_sum + odd_sum;
+                signal[i + quarter]     = even_diff + i_odd_diff;
+                signal[i + 2 * quarter] = even_sum - odd_sum;
+                signal[i + 3 * quarter] = even_diff - i_odd_diff;
+            }
+        }
+        FFTEMB_STAGE_END(start, cnl::log2p1(len) - 2, signal.data(), signal.size());
+    }
+}
+
+/**
+ * @brief Computes the split-radix butterflies of a signal in natural order, leaving the result bit reversed
+ *
+ * Decimation in frequency with L-shaped butterflies (Sorensen, Heideman and Burrus, 1986): every stage splits a
+ * block into a half-length transform and two quarter-length ones, the latter multiplied by W^j and W^3j. The passes
+ * are recorded in their order, from 0 for the one over the whole signal, up to log2(N) - 1 for the last one.
+ *
+ * @param[in,out] signal The signal in natural order
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+split_radix_stages(Container<T>& signal)
+{
+    const uint32_t n = signal.size();
+    if (n < 2) {
+        return;
+    }
+
+    for (uint32_t n2 = n; n2 >= 4; n2 >>= 1) {
+        FFTEMB_STAGE_BEGIN(start);
+        const auto           n4   = n2 / 4;
+        const auto           step = std::polar(1.0, 2 * std::numbers::pi / n2);
+        std::complex<double> w(1);
+        for (uint32_t j = 0; j < n4; ++j, w *= step) {
+            const auto w_cubed = w * w * w;
+            const T    w1(w.real(), w.imag());
+            const T    w3(w_cubed.real(), w_cubed.imag());
+
+            for (uint32_t is = j, id = 2 * n2; is < n - 1; is = 2 * id - n2 + j, id *= 4) {
+                for (uint32_t i0 = is; i0 < n - 1; i0 += id) {
+                    const auto i1 = i0 + n4;
+                    const auto i2 = i1 + n4;
+                    const auto i3 = i2 + n4;
+
+                    const auto a    = signal[i0] - signal[i2];
+                    const auto b    = signal[i1] - signal[i3];
+                    const auto i_b  = T(-b.imag(), b.real());
+                    signal[i0]      = signal[i0] + signal[i2];
+                    signal[i1]      = signal[i1] + signal[i3];
+                    signal[i2]      = a + i_b;
+                    signal[i3]      = a - i_b;
+                    if (j != 0) {
+                        signal[i2] = signal[i2] * w1;
+                        signal[i3] = signal[i3] * w3;
+                    }
+                }
+            }
+        }
+        FFTEMB_STAGE_END(start, cnl::log2p1(n) - cnl::log2p1(n2), signal.data(), signal.size());
+    }
+
+    // last stage, length-2 butterflies
+    FFTEMB_STAGE_BEGIN(start);
+    for (uint32_t is = 0, id = 4; is < n - 1; is = 2 * id - 2, id *= 4) {
+        for (uint32_t i0 = is; i0 < n - 1; i0 += id) {
+            auto u         = signal[i0];
+            auto v         = signal[i0 + 1];
+            signal[i0]     = u + v;
+            signal[i0 + 1] = u - v;
+        }
+    }
+    FFTEMB_STAGE_END(start, cnl::log2p1(n) - 2, signal.data(), signal.size());
+}
+
+/**
+ * @brief Computes the radix-2 butterfly stages of the inverse transform of a bit reversed spectrum
+ *
+ * The twiddle factors are conjugated and every stage halves its outputs, scaling the result by 1/N.
+ *
+ * @param[in,out] spectrum The bit reversed spectrum
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+inverse_radix2_stages(Container<T>& spectrum)
+{
+    const uint32_t               n = spectrum.size();
+    const typename T::value_type half{0.5};
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        const auto           step = std::polar(1.0, -2 * std::numbers::pi / len);
+        std::complex<double> w(1);
+        for (uint32_t j = 0; j < len / 2; ++j, w *= step) {
+            const T twiddle(w.real(), w.imag());
+            for (uint32_t i = j; i < n; i += len) {
+                auto u                = spectrum[i] * half;
+                auto v                = twiddle * spectrum[i + len / 2] * half;
+                spectrum[i]           = u + v;
+                spectrum[i + len / 2] = u - v;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes the radix-2 Stockham autosort stages of a signal in natural order, ping-ponging between two buffers
+ *
+ * The stage of length L splits each of the N / L interleaved sub-transforms in its even and odd halves: the
+ * elements p and p + L / 2 of every sub-transform are read as two runs of N / L consecutive elements, and written
+ * as two other runs. The spectrum comes out in natural order, without any bit reversal, and all the accesses are
+ * unit-stride. The twiddle factors follow a double precision recurrence, converted once per run.
+ *
+ * @param[in,out] input The signal, overwritten by the intermediate stages
+ * @param[out] output The scratch buffer, of the same size
+ * @param size The transform size (must be a power of 2)
+ * @return The buffer holding the spectrum, either input or output
+ */
+template <typename T>
+T*
+stockham_stages(T* input, T* output, std::size_t size)
+{
+    for (std::size_t length = size, stride = 1; length > 1; length /= 2, stride *= 2) {
+        const auto                 half = length / 2;
+        const std::complex<double> step = std::polar(1.0, 2 * std::numbers::pi / length);
+        std::complex<double>       w    = 1;
+        for (std::size_t p = 0; p < half; ++p) {
+            const T    twiddle(w.real(), w.imag());
+            const auto first  = input + stride * p;
+            const auto second = input + stride * (p + half);
+            const auto even   = output + 2 * stride * p;
+            const auto odd    = even + stride;
+            for (std::size_t q = 0; q < stride; ++q) {
+                const auto u = first[q];
+                const auto v = second[q];
+                even[q]      = u + v;
+                odd[q]       = (u - v) * twiddle;
+            }
+            w *= step;
+        }
+        std::swap(input, output);
+    }
+    return input;
+}
+
+/**
+ * @brief Get the largest magnitude among the real and imaginary parts of a sequence
+ *
+ * @param sequence The sequence of elements
+ * @return The largest magnitude
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+auto
+max_component(const Container<T>& sequence)
+{
+    using Real = typename T::value_type;
+    Real max_value{0};
+    Real min_value{0};
+    for (const auto& bin : sequence) {
+        max_value = std::max({max_value, bin.real(), bin.imag()});
+        min_value = std::min({min_value, bin.real(), bin.imag()});
+    }
+    return std::max(max_value, Real(-min_value));
+}
+
+/**
+ * @brief Computes the radix-2 butterfly stages of a bit reversed signal with block floating-point scaling
+ *
+ * Each component of a butterfly output is at most 1 + sqrt(2) times the largest input component, so a stage whose
+ * input exceeds the largest value of the type divided by that factor shifts its inputs right by 1 or 2 bits, before
+ * the twiddle multiply, until they fit below it. The extremes of the output components are tracked within the
+ * butterflies, for the check of the next stage.
+ *
+ * @param[in,out] signal The bit reversed signal
+ * @return The number of halvings, i.e. the exponent of the shared scale factor of the result
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+int
+block_floating_point_stages(Container<T>& signal)
+{
+    using Real = typename T::value_type;
+
+    const uint32_t n         = signal.size();
+    const Real     half{0.5};
+    const Real     quarter{0.25};
+    const Real     headroom{static_cast<double>(std::numeric_limits<Real>::max()) / (1 + std::numbers::sqrt2)};
+    int            exponent = 0;
+    auto           max_in   = max_component(signal);
+
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        // 1 + sqrt(2) < 4, so a shift of 2 bits always brings a representable input below the headroom
+        const int shift = max_in <= headroom ? 0 : Real(max_in * half) <= headroom ? 1 : 2;
+        exponent += shift;
+        Real max_out{0};
+        Real min_out{0};
+
+        const auto           step = std::polar(1.0, 2 * std::numbers::pi / len);
+        std::complex<double> w(1);
+        for (uint32_t j = 0; j < len / 2; ++j, w *= step) {
+            const T twiddle(w.real(), w.imag());
+            for (uint32_t i = j; i < n; i += len) {
+                auto u = signal[i];
+                auto v = signal[i + len / 2];
+                if (shift == 1) {
+                    u = u * half;
+                    v = v * half;
+                }
+                else if (shift == 2) {
+                    u = u * quarter;
+                    v = v * quarter;
+                }
+                v                   = twiddle * v;
+                signal[i]           = u + v;
+                signal[i + len / 2] = u - v;
+                max_out = std::max({max_out, signal[i].real(), signal[i].imag(), signal[i + len / 2].real(),
+                                    signal[i + len / 2].imag()});
+                min_out = std::min({min_out, signal[i].real(), signal[i].imag(), signal[i + len / 2].real(),
+                                    signal[i + len / 2].imag()});
+            }
+        }
+        max_in = std::max(max_out, Real(-min_out));
+    }
+    return exponent;
+}
+
+/**
+ * @brief Computes the butterfly stage of length Len, followed by all the longer ones
+ *
+ * @tparam N The transform size
+ * @tparam Len The length of the stage
+ * @param[in,out] signal The bit reversed signal
+ */
+template <std::size_t N, std::size_t Len, typename T, template <class...> class Container>
+void
+static_butterfly_stages(Container<T>& signal)
+{
+    constexpr auto half     = Len / 2;
+    constexpr auto stride   = N / Len;
+    const auto&    twiddles = k_twiddle_rom<N, T>;
+
+    for (std::size_t i = 0; i < N; i += Len) {
+        for (std::size_t j = 0; j < half; ++j) {
+            auto u               = signal[i + j];
+            auto v               = twiddles[j * stride] * signal[i + j + half];
+            signal[i + j]        = u + v;
+            signal[i + j + half] = u - v;
+        }
+    }
+    if constexpr (Len < N) {
+        static_butterfly_stages<N, Len * 2>(signal);
+    }
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Computes the in-place FFT transform
+ *
+ * The radix-2 kernel of a Complex or FastComplex signal runs on its raw Q11.20 integers, through the SIMD engine of
+ * fft_simd.hpp selected for the running CPU. The results are the same as CNL's, except that out of range values
+ * saturate, as described at FftKernel.
+ *
+ * Sizes that are not powers of 2 are transformed at their native length by a MixedRadixPlan, regardless of the
+ * kernel, and the size of the container is left untouched. The plan comes from the cache of mixed_radix_plan(), so
+ * only the first transform of a size on a thread allocates and computes the tables.
+ *
+ * @param[in,out] signal The signal to be transformed
+ * @param kernel The butterfly kernel used for powers of 2
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+compute(Container<T>& signal, FftKernel kernel = FftKernel::radix2)
+{
+    FFTEMB_PROBE(compute);
+    if (signal.size() <= 1) {
+        return;
+    }
+    if (!cnl::ispow2(signal.size())) {
+        mixed_radix_plan<T>(signal.size()).template execute<Container>(signal);
+        return;
+    }
+
+    switch (kernel) {
+    case FftKernel::radix4:
+        fft_utils::bit_reversal<T, Container>(signal);
+        fft_utils::radix4_stages<T, Container>(signal);
+        break;
+    case FftKernel::split_radix:
+        fft_utils::split_radix_stages<T, Container>(signal);
+        fft_utils::bit_reversal<T, Container>(signal);
+        break;
+    default:
+        if constexpr (simd::k_is_q20_layout<T>) {
+            simd::transform_q20(reinterpret_cast<int32_t*>(signal.data()), signal.size());
+        } else {
+            fft_utils::bit_reversal<T, Container>(signal);
+            fft_utils::radix2_stages<T, Container>(signal);
+        }
+        break;
+    }
+}
+
+/**
+ * @brief Computes the in-place FFT transform on memory owned by the caller, such as a DMA or an mmap buffer
+ *
+ * The signal is neither copied nor resized, and powers of 2 are transformed without any allocation; the other sizes
+ * go through the cached MixedRadixPlan of their size, as in the overload for containers.
+ *
+ * @param[in,out] signal The signal to be transformed
+ * @param kernel The butterfly kernel used for powers of 2
+ */
+template <typename T, std::size_t Extent>
+void
+compute(std::span<T, Extent> signal, FftKernel kernel = FftKernel::radix2)
+{
+    Span<T> view(signal);
+    compute<T, Span>(view, kernel);
+}
+
+/**
+ * @brief Views interleaved real and imaginary raw Q11.20 integers as complex numbers, without copying them
+ *
+ * The raw value r stands for r / 2^20. The view can be passed to the overloads taking spans, so that the transform
+ * runs directly on the integers, through the SIMD engine.
+ *
+ * @tparam T The complex type, Complex or FastComplex
+ * @param raw The interleaved real and imaginary parts, 2 integers per complex number
+ * @return The complex numbers
+ */
+template <typename T = Complex>
+std::span<T>
+interleaved_view(std::span<int32_t> raw)
+{
+    static_assert(simd::k_is_q20_layout<T> && alignof(T) <= alignof(int32_t),
+                  "The complex type must be laid out as a pair of raw Q11.20 integers");
+    return {reinterpret_cast<T*>(raw.data()), raw.size() / 2};
+}
+
+/**
+ * @brief Computes the FFT transform with the Stockham autosort stages, in the signal and a scratch buffer
+ *
+ * No bit reversal pass is needed and every stage streams through both buffers with unit stride, which suits large
+ * sizes better than the scattered accesses of the in-place path. Sizes that are not powers of 2 are transformed
+ * by the cached MixedRadixPlan of their size, as in compute().
+ *
+ * @param[in,out] signal The signal to be transformed
+ * @param scratch A buffer of at least as many elements as the signal, overwritten
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+compute_stockham(Container<T>& signal, Container<T>& scratch)
+{
+    if (signal.size() <= 1) {
+        return;
+    }
+    if (!cnl::ispow2(signal.size())) {
+        mixed_radix_plan<T>(signal.size()).execute(signal);
+        return;
+    }
+
+    const auto* spectrum = fft_utils::stockham_stages(signal.data(), scratch.data(), signal.size());
+    if (spectrum != signal.data()) {
+        std::copy_n(spectrum, signal.size(), signal.data());
+    }
+}
+
+/**
+ * @brief Computes the in-place inverse FFT transform, scaled by 1/N
+ *
+ * @param[in,out] spectrum The spectrum to be transformed (its size must be a power of 2)
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+compute_inverse(Container<T>& spectrum)
+{
+    fft_utils::bit_reversal(spectrum);
+    fft_utils::inverse_radix2_stages(spectrum);
+}
+
+/**
+ * @brief Computes the in-place FFT transform in block floating-point, without the need to normalize the signal
+ *
+ * The signal shares a single exponent, incremented whenever a stage must be halved to avoid overflowing the
+ * fixed-point type. The actual spectrum is the result multiplied by 2 to the power of the returned exponent.
+ *
+ * Sizes that are not powers of 2 are transformed at their native length by a MixedRadixPlan, whose stages cannot be
+ * rescaled on the way: the signal is shifted once beforehand, by the exponent that keeps the bound sqrt(2) N of the
+ * largest input component within the type, which costs more precision than the scaling per stage.
+ *
+ * @param[in,out] signal The signal to be transformed
+ * @return The exponent of the shared scale factor
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+int
+compute_block_floating_point(Container<T>& signal)
+{
+    using Real = typename T::value_type;
+
+    const std::size_t size = signal.size();
+    if (size <= 1) {
+        return 0;
+    }
+    if (!cnl::ispow2(size)) {
+        const auto bound    = std::numbers::sqrt2 * size * static_cast<double>(fft_utils::max_component(signal));
+        const auto max      = static_cast<double>(std::numeric_limits<Real>::max());
+        int        exponent = 0;
+        while (bound > std::ldexp(max, exponent)) {
+            ++exponent;
+        }
+        if (exponent > 0) {
+            const auto scale = static_cast<Real>(std::ldexp(1.0, -exponent));
+            for (std::size_t i = 0; i < size; ++i) {
+                signal[i] = signal[i] * scale;
+            }
+        }
+        mixed_radix_plan<T>(size).execute(signal);
+        return exponent;
+    }
+
+    fft_utils::bit_reversal(signal);
+    return fft_utils::block_floating_point_stages(signal);
+}
+
+/**
+ * @brief Computes the in-place FFT transform of a size known at compile time
+ *
+ * The twiddle factors and the bit reversal swaps are read from tables generated at compile time, and the stage
+ * loop bounds are constants, so no trigonometry or size check happens at run time.
+ *
+ * @tparam N The transform size (must be a power of 2)
+ * @param[in,out] signal The signal to be transformed, with exactly N elements
+ */
+template <std::size_t N, typename T = Complex, template <class...> class Container = etl::ivector>
+void
+compute(Container<T>& signal)
+{
+    static_assert(cnl::ispow2(N), "The transform size must be a power of 2");
+
+    for (const auto& [i, j] : fft_utils::k_bit_reversal_swaps<N>) {
+        std::swap(signal[i], signal[j]);
+    }
+    if constexpr (N > 1) {
+        fft_utils::static_butterfly_stages<N, 2>(signal);
     }
 }
 
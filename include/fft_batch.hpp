@@ -0,0 +1,238 @@
+/**
+ * @file fft_batch.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the batched multi-channel FFT
+ */
+
+#ifndef H_FFT_BATCH_HPP
+#define H_FFT_BATCH_HPP
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+#include "etl/vector.h"
+#include "fft_mixed_radix.hpp"
+#include "fft_simd.hpp"
+#include "fft_tables.hpp"
+#include "fft_types.hpp"
+
+namespace fftemb
+{
+/// @brief The memory layouts of a batch of channels of the same size
+enum class BatchLayout
+{
+    /// @brief Sample i of channel c at i * channels + c, so that the channels of a sample are contiguous
+    channel_minor,
+    /// @brief Sample i of channel c at c * size + i, so that each channel is contiguous
+    channel_major
+};
+
+namespace fft_utils
+{
+/// @brief The size of the groups of channels transformed together in the channel-major layout, about half an L2
+inline constexpr std::size_t k_batch_group_bytes = 128 * 1024;
+
+/**
+ * @brief Applies the bit reversal permutation to every channel of a batch
+ *
+ * @param[in,out] signals The batch of signals
+ * @param size The number of samples of each channel
+ * @param channels The number of channels
+ * @param layout The memory layout of the batch
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+batch_bit_reversal(Container<T>& signals, std::size_t size, std::size_t channels, BatchLayout layout)
+{
+    const auto levels = static_cast<std::size_t>(cnl::log2p1(size) - 1);
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto j = reverse_bits(i, levels);
+        if (j <= i) {
+            continue;
+        }
+        for (std::size_t c = 0; c < channels; ++c) {
+            if (layout == BatchLayout::channel_minor) {
+                std::swap(signals[i * channels + c], signals[j * channels + c]);
+            }
+            else {
+                std::swap(signals[c * size + i], signals[c * size + j]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes the radix-2 butterfly stages of a bit reversed batch, loading each twiddle factor once for all
+ * the channels
+ *
+ * @param[in,out] signals The bit reversed batch of signals
+ * @param size The number of samples of each channel
+ * @param channels The number of channels
+ * @param layout The memory layout of the batch
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+batch_radix2_stages(Container<T>& signals, std::size_t size, std::size_t channels, BatchLayout layout)
+{
+    // distance between consecutive samples of a channel, and between the first samples of consecutive channels
+    const auto sample_stride  = layout == BatchLayout::channel_minor ? channels : 1;
+    const auto channel_stride = layout == BatchLayout::channel_minor ? 1 : size;
+
+    for (std::size_t len = 2; len <= size; len <<= 1) {
+        const auto           half = len / 2;
+        const auto           step = std::polar(1.0, 2 * std::numbers::pi / len);
+        std::complex<double> w(1);
+        for (std::size_t j = 0; j < half; ++j, w *= step) {
+            const T twiddle(w.real(), w.imag());
+            for (std::size_t c = 0; c < channels; ++c) {
+                for (std::size_t i = j; i < size; i += len) {
+                    auto& top    = signals[c * channel_stride + i * sample_stride];
+                    auto& bottom = signals[c * channel_stride + (i + half) * sample_stride];
+                    auto  u      = top;
+                    auto  v      = twiddle * bottom;
+                    top          = u + v;
+                    bottom       = u - v;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes the radix-2 FFT of a batch of raw Q11.20 signals with the SIMD engine
+ *
+ * Each run of twiddle factors is generated once for the whole batch. In the channel-minor layout, a twiddle factor
+ * is broadcast across the channels, so that the butterflies of all the channels of a sample pair run as one
+ * contiguous vector loop.
+ *
+ * @param[in,out] data The interleaved real and imaginary parts of the batch
+ * @param size The number of samples of each channel
+ * @param channels The number of channels
+ * @param layout The memory layout of the batch
+ * @param isa The instruction set
+ */
+inline void
+batch_transform_q20(int32_t* data, std::size_t size, std::size_t channels, BatchLayout layout,
+                    simd::Isa isa = simd::active_isa())
+{
+    int32_t    twiddles[2 * simd::k_twiddle_chunk];
+    int32_t    broadcast[2 * simd::k_twiddle_chunk];
+    const auto levels = static_cast<std::size_t>(cnl::log2p1(size) - 1);
+
+    if (layout == BatchLayout::channel_minor) {
+        // the samples are blocks of 2 * channels integers
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto j = reverse_bits(i, levels);
+            if (j > i) {
+                std::swap_ranges(data + 2 * i * channels, data + 2 * (i + 1) * channels, data + 2 * j * channels);
+            }
+        }
+        for (std::size_t len = 2; len <= size; len <<= 1) {
+            const auto half = len / 2;
+            for (std::size_t first = 0; first < half; first += simd::k_twiddle_chunk) {
+                const auto count = std::min(simd::k_twiddle_chunk, half - first);
+                simd::fill_twiddles(twiddles, len, first, count);
+                for (std::size_t j = 0; j < count; ++j) {
+                    for (std::size_t c0 = 0; c0 < channels; c0 += simd::k_twiddle_chunk) {
+                        const auto run = std::min(simd::k_twiddle_chunk, channels - c0);
+                        for (std::size_t c = 0; c < run; ++c) {
+                            broadcast[2 * c]     = twiddles[2 * j];
+                            broadcast[2 * c + 1] = twiddles[2 * j + 1];
+                        }
+                        for (std::size_t i = first + j; i < size; i += len) {
+                            simd::butterflies(data + 2 * (i * channels + c0),
+                                              data + 2 * ((i + half) * channels + c0),
+                                              broadcast,
+                                              run,
+                                              isa);
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    // the channels are transformed in groups that fit in the cache, the twiddle factors being shared by a group
+    const auto group = std::max<std::size_t>(1, k_batch_group_bytes / (2 * sizeof(int32_t) * size));
+    for (std::size_t g0 = 0; g0 < channels; g0 += group) {
+        const auto g1 = std::min(channels, g0 + group);
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto j = reverse_bits(i, levels);
+            for (std::size_t c = g0; j > i && c < g1; ++c) {
+                auto* channel = data + 2 * c * size;
+                std::swap(channel[2 * i], channel[2 * j]);
+                std::swap(channel[2 * i + 1], channel[2 * j + 1]);
+            }
+        }
+        for (std::size_t c = g0; c < g1; ++c) {
+            simd::first_stages(data + 2 * c * size, size);
+        }
+        for (std::size_t len = 8; len <= size; len <<= 1) {
+            const auto half = len / 2;
+            for (std::size_t first = 0; first < half; first += simd::k_twiddle_chunk) {
+                const auto count = std::min(simd::k_twiddle_chunk, half - first);
+                simd::fill_twiddles(twiddles, len, first, count);
+                for (std::size_t c = g0; c < g1; ++c) {
+                    auto* channel = data + 2 * c * size;
+                    for (std::size_t i = 0; i < size; i += len) {
+                        simd::butterflies(
+                            channel + 2 * (i + first), channel + 2 * (i + first + half), twiddles, count, isa);
+                    }
+                }
+            }
+        }
+    }
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Computes the in-place FFT transforms of a batch of signals of the same size
+ *
+ * The trigonometry and the bit reversal indices are computed once for the whole batch. A Complex batch runs on its
+ * raw Q11.20 integers through the SIMD engine, with the same results as compute() on each channel. Sizes that are not
+ * powers of 2 are transformed channel by channel, through a copy, by the cached MixedRadixPlan of compute().
+ *
+ * @param[in,out] signals The batch of signals, with channels * size elements
+ * @param channels The number of channels, none leaving the batch untouched
+ * @param layout The memory layout of the batch
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+compute_batch(Container<T>& signals, std::size_t channels, BatchLayout layout = BatchLayout::channel_minor)
+{
+    const auto size = channels == 0 ? 0 : signals.size() / channels;
+    if (size <= 1) {
+        return;
+    }
+    if (!cnl::ispow2(size)) {
+        auto&          plan = mixed_radix_plan<T>(size);
+        std::vector<T> channel(size);
+        for (std::size_t c = 0; c < channels; ++c) {
+            const auto first  = layout == BatchLayout::channel_minor ? c : c * size;
+            const auto stride = layout == BatchLayout::channel_minor ? channels : 1;
+            for (std::size_t i = 0; i < size; ++i) {
+                channel[i] = signals[first + i * stride];
+            }
+            plan.execute(channel);
+            for (std::size_t i = 0; i < size; ++i) {
+                signals[first + i * stride] = channel[i];
+            }
+        }
+        return;
+    }
+
+    if constexpr (simd::k_is_q20_layout<T>) {
+        fft_utils::batch_transform_q20(reinterpret_cast<int32_t*>(signals.data()), size, channels, layout);
+    }
+    else {
+        fft_utils::batch_bit_reversal(signals, size, channels, layout);
+        fft_utils::batch_radix2_stages(signals, size, channels, layout);
+    }
+}
+
+}  // namespace fftemb
+
+#endif  // H_FFT_BATCH_HPP
@@ -0,0 +1,132 @@
+/**
+ * @file fft_four_step.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the multithreaded four-step FFT for large transform sizes
+ */
+
+#ifndef H_FFT_FOUR_STEP_HPP
+#define H_FFT_FOUR_STEP_HPP
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include "dsp_utils.hpp"
+#include "etl/vector.h"
+#include "fft.hpp"
+#include "fft_simd.hpp"
+#include "fft_types.hpp"
+#include "thread_pool.hpp"
+
+namespace fftemb
+{
+namespace fft_utils
+{
+/// @brief The side of the square tiles of the transposes, 32x32 Complex numbers taking 8 KiB
+inline constexpr std::size_t k_transpose_tile = 32;
+
+/**
+ * @brief Transposes a row-major matrix out of place, by tiles spread over the thread pool
+ *
+ * @param in The matrix
+ * @param[out] out The transposed matrix
+ * @param rows The number of rows of the matrix
+ * @param cols The number of columns of the matrix
+ * @param pool The thread pool
+ */
+template <typename T>
+void
+parallel_transpose(const T* in, T* out, std::size_t rows, std::size_t cols, ThreadPool& pool)
+{
+    const auto tile_rows = (rows + k_transpose_tile - 1) / k_transpose_tile;
+    pool.parallel_for(tile_rows, [=](std::size_t tile_row) {
+        const auto r0 = tile_row * k_transpose_tile;
+        const auto r1 = std::min(rows, r0 + k_transpose_tile);
+        for (std::size_t c0 = 0; c0 < cols; c0 += k_transpose_tile) {
+            const auto c1 = std::min(cols, c0 + k_transpose_tile);
+            for (std::size_t r = r0; r < r1; ++r) {
+                for (std::size_t c = c0; c < c1; ++c) {
+                    out[c * rows + r] = in[r * cols + c];
+                }
+            }
+        }
+    });
+}
+
+/**
+ * @brief Computes the in-place FFT of a contiguous row of a matrix
+ *
+ * @param row The first element of the row
+ * @param size The number of elements of the row (must be a power of 2)
+ */
+template <typename T>
+void
+row_fft(T* row, std::size_t size)
+{
+    if constexpr (simd::k_is_q20_layout<T>) {
+        simd::transform_q20(reinterpret_cast<int32_t*>(row), size);
+    }
+    else {
+        compute(std::span<T>(row, size));
+    }
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Computes the in-place FFT transform with the four-step (Bailey) algorithm, spread over a thread pool
+ *
+ * The signal of size N = N1 * N2 is seen as a N2 x N1 matrix. After a transpose, the N1 rows get FFTs of size N2 and
+ * are multiplied by the twiddle factors e^(2πi n1 k2 / N); after another transpose, the N2 rows get FFTs of size N1,
+ * and a last transpose puts the spectrum in natural order. Every FFT runs on a contiguous row that fits in the
+ * cache, unlike the late stages of compute(), which stride across the whole signal. Use it for large sizes
+ * (2^16 and above); the transposes go through a scratch buffer as large as the signal, owned by the caller so that
+ * it is allocated once. Sizes that are not powers of 2 are transformed by compute(), through a MixedRadixPlan, on the
+ * calling thread.
+ *
+ * @param[in,out] signal The signal to be transformed
+ * @param scratch A buffer of at least as many elements as the signal, overwritten
+ * @param pool The thread pool running the row FFTs and the transposes
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+compute_four_step(Container<T>& signal, Container<T>& scratch, ThreadPool& pool)
+{
+    const std::size_t size = signal.size();
+    if (size < 4 || !cnl::ispow2(size)) {
+        compute(signal);
+        return;
+    }
+
+    // N1 = 2^floor(log2(N) / 2), N2 = N / N1
+    const std::size_t n1   = std::size_t{1} << ((cnl::log2p1(size) - 1) / 2);
+    const std::size_t n2   = size / n1;
+    T*                data = signal.data();
+    T*                work = scratch.data();
+
+    fft_utils::parallel_transpose(data, work, n2, n1, pool);
+    pool.parallel_for(n1, [=](std::size_t row) {
+        fft_utils::row_fft(work + row * n2, n2);
+        // twiddle factors e^(2πi row k / N), from a double precision recurrence along the row
+        const auto angle = 2 * std::numbers::pi * row / size;
+        if constexpr (simd::k_is_q20_layout<T>) {
+            simd::multiply_by_powers(reinterpret_cast<int32_t*>(work + row * n2), n2, angle);
+        }
+        else {
+            const auto           step = std::polar(1.0, angle);
+            std::complex<double> w(1);
+            for (std::size_t k = 1; k < n2; ++k) {
+                w *= step;
+                work[row * n2 + k] = work[row * n2 + k] * T(w.real(), w.imag());
+            }
+        }
+    });
+    fft_utils::parallel_transpose(work, data, n1, n2, pool);
+    pool.parallel_for(n2, [=](std::size_t row) { fft_utils::row_fft(data + row * n1, n1); });
+    fft_utils::parallel_transpose(data, work, n2, n1, pool);
+    pool.parallel_for(n1, [=](std::size_t row) { std::copy_n(work + row * n2, n2, data + row * n2); });
+}
+
+}  // namespace fftemb
+
+#endif  // H_FFT_FOUR_STEP_HPP
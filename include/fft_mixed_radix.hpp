@@ -0,0 +1,435 @@
+/**
+ * @file fft_mixed_radix.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the MixedRadixPlan class, for transform sizes that are not powers of 2
+ */
+
+#ifndef H_FFT_MIXED_RADIX_HPP
+#define H_FFT_MIXED_RADIX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <numbers>
+#include <vector>
+#include "etl/vector.h"
+#include "fft_types.hpp"
+
+namespace fftemb
+{
+namespace fft_utils
+{
+/// @brief The largest prime factor transformed by a direct DFT butterfly; larger ones go through Bluestein
+inline constexpr std::size_t k_max_direct_radix = 13;
+
+/**
+ * @brief Splits a transform size in the radices of its stages, radix 4 first
+ *
+ * @param size The transform size
+ * @return The radices, whose product is the size, none for sizes 0 and 1
+ */
+inline std::vector<std::size_t>
+factorize(std::size_t size)
+{
+    std::vector<std::size_t> radices;
+    if (size <= 1) {
+        return radices;
+    }
+    while (size % 4 == 0) {
+        radices.push_back(4);
+        size /= 4;
+    }
+    for (std::size_t p = 2; p * p <= size; ++p) {
+        while (size % p == 0) {
+            radices.push_back(p);
+            size /= p;
+        }
+    }
+    if (size > 1) {
+        radices.push_back(size);
+    }
+    return radices;
+}
+
+/**
+ * @brief Get the smallest size at least as large as the given one whose prime factors are 2, 3 and 5 only
+ *
+ * @param size The minimum size
+ * @return The 5-smooth size
+ */
+inline std::size_t
+next_smooth_size(std::size_t size)
+{
+    for (;; ++size) {
+        auto rest = size;
+        for (const std::size_t p : {2, 3, 5}) {
+            while (rest % p == 0) {
+                rest /= p;
+            }
+        }
+        if (rest == 1) {
+            return size;
+        }
+    }
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Holds the tables and the scratch memory of a FFT of any size, known at run time
+ *
+ * Sizes whose prime factors are all up to 13 run as a Stockham autosort FFT at their native length, with radix 2,
+ * 3, 4 and 5 butterflies and a direct DFT for 7, 11 and 13. The stages ping-pong between the signal and a scratch
+ * buffer, so the spectrum comes out in natural order without any bit reversal.
+ *
+ * Other sizes go through Bluestein's chirp-z algorithm: the transform becomes a circular convolution with a chirp,
+ * computed with an inner mixed-radix transform of a 5-smooth size M >= 2N - 1. As in OverlapSaveConvolver, the
+ * conjugated input goes through the inner inverse transform, which divides every other stage by its radix. The
+ * inner spectrum is thus scaled by about 1/sqrt(M): no intermediate result grows beyond the spectrum itself, while
+ * the energy spread over the M bins keeps most of the fractional bits.
+ *
+ * All the memory is allocated on construction, execute() neither allocates nor resizes the signal.
+ *
+ * @tparam T The complex number type
+ */
+template <typename T = Complex>
+class MixedRadixPlan
+{
+public:
+    using Real = typename T::value_type;
+
+    /**
+     * @brief Construct a new plan, factorizing the size and computing the tables
+     *
+     * @param size The transform size
+     */
+    explicit MixedRadixPlan(std::size_t size);
+
+    /**
+     * @brief Computes the in-place FFT transform
+     *
+     * @param[in,out] signal The signal to be transformed, with exactly size() elements
+     */
+    template <template <class...> class Container>
+    void
+    execute(Container<T>& signal);
+
+    /**
+     * @brief Get the transform size
+     *
+     * @return The number of elements of the transformed signals
+     */
+    std::size_t
+    size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief Get the radices of the stages
+     *
+     * @return The radices, empty when the transform goes through Bluestein's algorithm
+     */
+    const std::vector<std::size_t>&
+    radices() const
+    {
+        return m_radices;
+    }
+
+    /**
+     * @brief Get whether the transform goes through Bluestein's algorithm
+     *
+     * @return True if the size has a prime factor larger than fft_utils::k_max_direct_radix
+     */
+    bool
+    uses_bluestein() const
+    {
+        return m_inner != nullptr;
+    }
+
+private:
+    /**
+     * @brief Computes the Stockham stages in place, through the scratch buffer
+     *
+     * @param data The signal
+     * @param inverse Whether to compute the inverse transform, every other stage divided by its radix
+     */
+    void
+    stages(T* data, bool inverse);
+
+    /**
+     * @brief Get the scale factor of the inverse stages
+     *
+     * @return The product of the radices of the stages divided by them
+     */
+    std::size_t
+    inverse_scale() const;
+
+    /**
+     * @brief Computes a stage of a given radix, out of place
+     *
+     * @param in The outputs of the previous stage, sub-transforms of length l
+     * @param out The sub-transforms of length l * radix
+     * @param l The length of the input sub-transforms
+     * @param radix The radix of the stage
+     * @param inverse Whether to use the inverse twiddle factors
+     * @param scaled Whether to divide the outputs by the radix
+     */
+    void
+    stage(const T* in, T* out, std::size_t l, std::size_t radix, bool inverse, bool scaled) const;
+
+    /**
+     * @brief Computes the transform with Bluestein's algorithm
+     *
+     * @param data The signal
+     */
+    void
+    bluestein(T* data);
+
+    /// @brief The transform size
+    std::size_t m_size;
+    /// @brief The radices of the stages
+    std::vector<std::size_t> m_radices;
+    /// @brief The twiddle factors e^(2πik/N), for k from 0 to N - 1
+    std::vector<T> m_twiddles;
+    /// @brief The scratch buffer of the stages
+    std::vector<T> m_scratch;
+    /// @brief The chirp e^(πin²/N) of Bluestein's algorithm
+    std::vector<T> m_chirp;
+    /// @brief The conjugate spectrum of the convolution chirp of Bluestein's algorithm
+    std::vector<T> m_chirp_spectrum;
+    /// @brief The work buffer of Bluestein's algorithm
+    std::vector<T> m_work;
+    /// @brief The plan of the inner transforms of Bluestein's algorithm
+    std::unique_ptr<MixedRadixPlan<T>> m_inner;
+};
+
+template <typename T>
+MixedRadixPlan<T>::MixedRadixPlan(std::size_t size) : m_size(size)
+{
+    const auto radices = fft_utils::factorize(size);
+    if (!radices.empty() && radices.back() > fft_utils::k_max_direct_radix) {
+        const auto inner_size = fft_utils::next_smooth_size(2 * size - 1);
+        m_inner               = std::make_unique<MixedRadixPlan<T>>(inner_size);
+        m_work.resize(inner_size);
+        m_chirp.resize(size);
+
+        // n² mod 2N keeps the angle of the chirp exact for large n
+        std::vector<std::complex<double>> convolution_chirp(inner_size);
+        for (std::size_t n = 0; n < size; ++n) {
+            const auto angle     = std::numbers::pi * static_cast<double>((uint64_t{n} * n) % (2 * size)) / size;
+            m_chirp[n]           = T(std::cos(angle), std::sin(angle));
+            convolution_chirp[n] = std::polar(1.0, -angle);
+            if (n > 0) {
+                convolution_chirp[inner_size - n] = std::polar(1.0, -angle);
+            }
+        }
+        MixedRadixPlan<std::complex<double>>(inner_size).execute<std::vector>(convolution_chirp);
+        // the rest of the 1/M of the convolution, not applied by the inverse stages
+        const auto rest = static_cast<double>(m_inner->inverse_scale()) / inner_size;
+        m_chirp_spectrum.resize(inner_size);
+        for (std::size_t k = 0; k < inner_size; ++k) {
+            m_chirp_spectrum[k] = T(rest * convolution_chirp[k].real(), -rest * convolution_chirp[k].imag());
+        }
+        return;
+    }
+
+    m_radices = radices;
+    m_scratch.resize(size);
+    m_twiddles.resize(size);
+    for (std::size_t k = 0; k < size; ++k) {
+        const auto angle = 2 * std::numbers::pi * k / size;
+        m_twiddles[k]    = T(std::cos(angle), std::sin(angle));
+    }
+}
+
+template <typename T>
+template <template <class...> class Container>
+void
+MixedRadixPlan<T>::execute(Container<T>& signal)
+{
+    if (m_inner) {
+        bluestein(signal.data());
+    }
+    else {
+        stages(signal.data(), false);
+    }
+}
+
+template <typename T>
+void
+MixedRadixPlan<T>::stages(T* data, bool inverse)
+{
+    const T* in  = data;
+    T*       out = m_scratch.data();
+    for (std::size_t i = 0, l = 1; i < m_radices.size(); l *= m_radices[i], ++i) {
+        stage(in, out, l, m_radices[i], inverse, inverse && i % 2 == 1);
+        in  = out;
+        out = out == data ? m_scratch.data() : data;
+    }
+    if (in != data) {
+        std::copy_n(in, m_size, data);
+    }
+}
+
+template <typename T>
+std::size_t
+MixedRadixPlan<T>::inverse_scale() const
+{
+    std::size_t scale = 1;
+    for (std::size_t i = 1; i < m_radices.size(); i += 2) {
+        scale *= m_radices[i];
+    }
+    return scale;
+}
+
+template <typename T>
+void
+MixedRadixPlan<T>::stage(const T* in, T* out, std::size_t l, std::size_t radix, bool inverse, bool scaled) const
+{
+    // sub-transform s' of the stage (of length L = l * radix) merges the sub-transforms s' + r * q of the previous
+    // one, for q from 0 to radix - 1, with r = N / L
+    const auto len   = l * radix;
+    const auto r     = m_size / len;
+    const auto scale = static_cast<Real>(1.0 / radix);
+    // multiplies by ±i, the sign being the one of the transform
+    const auto rotate = [inverse](const T& z) { return inverse ? T(z.imag(), -z.real()) : T(-z.imag(), z.real()); };
+
+    const auto half    = static_cast<Real>(0.5);
+    const auto sin_3   = static_cast<Real>(std::sin(2 * std::numbers::pi / 3));
+    const auto cos_5_1 = static_cast<Real>(std::cos(2 * std::numbers::pi / 5));
+    const auto cos_5_2 = static_cast<Real>(std::cos(4 * std::numbers::pi / 5));
+    const auto sin_5_1 = static_cast<Real>(std::sin(2 * std::numbers::pi / 5));
+    const auto sin_5_2 = static_cast<Real>(std::sin(4 * std::numbers::pi / 5));
+
+    T z[fft_utils::k_max_direct_radix];
+    for (std::size_t s = 0; s < r; ++s) {
+        for (std::size_t k = 0; k < l; ++k) {
+            // twiddle factor e^(2πiqk/L) at index q * k * r of the table
+            for (std::size_t q = 0; q < radix; ++q) {
+                z[q] = in[k + l * s + l * r * q];
+                if (scaled) {
+                    z[q] = z[q] * scale;
+                }
+                if (q != 0 && k != 0) {
+                    const auto& w = m_twiddles[q * k * r];
+                    z[q]          = (inverse ? std::conj(w) : w) * z[q];
+                }
+            }
+            T* y = out + k + len * s;
+            switch (radix) {
+            case 2:
+                y[0] = z[0] + z[1];
+                y[l] = z[0] - z[1];
+                break;
+            case 3: {
+                const auto sum  = z[1] + z[2];
+                const auto mid  = z[0] - sum * half;
+                const auto diff = rotate(z[1] - z[2]) * sin_3;
+                y[0]            = z[0] + sum;
+                y[l]            = mid + diff;
+                y[2 * l]        = mid - diff;
+                break;
+            }
+            case 4: {
+                const auto even_sum  = z[0] + z[2];
+                const auto even_diff = z[0] - z[2];
+                const auto odd_sum   = z[1] + z[3];
+                const auto odd_diff  = rotate(z[1] - z[3]);
+                y[0]                 = even_sum + odd_sum;
+                y[l]                 = even_diff + odd_diff;
+                y[2 * l]             = even_sum - odd_sum;
+                y[3 * l]             = even_diff - odd_diff;
+                break;
+            }
+            case 5: {
+                const auto sum_1  = z[1] + z[4];
+                const auto sum_2  = z[2] + z[3];
+                const auto diff_1 = z[1] - z[4];
+                const auto diff_2 = z[2] - z[3];
+                const auto mid_1  = z[0] + sum_1 * cos_5_1 + sum_2 * cos_5_2;
+                const auto mid_2  = z[0] + sum_1 * cos_5_2 + sum_2 * cos_5_1;
+                const auto rot_1  = rotate(diff_1 * sin_5_1 + diff_2 * sin_5_2);
+                const auto rot_2  = rotate(diff_1 * sin_5_2 - diff_2 * sin_5_1);
+                y[0]              = z[0] + sum_1 + sum_2;
+                y[l]              = mid_1 + rot_1;
+                y[2 * l]          = mid_2 + rot_2;
+                y[3 * l]          = mid_2 - rot_2;
+                y[4 * l]          = mid_1 - rot_1;
+                break;
+            }
+            default:
+                // direct DFT, the powers of e^(2πi/radix) being every (N / radix)-th twiddle factor
+                for (std::size_t j = 0; j < radix; ++j) {
+                    auto sum = z[0];
+                    for (std::size_t q = 1; q < radix; ++q) {
+                        const auto& w = m_twiddles[(q * j % radix) * (m_size / radix)];
+                        sum           = sum + (inverse ? std::conj(w) : w) * z[q];
+                    }
+                    y[j * l] = sum;
+                }
+                break;
+            }
+        }
+    }
+}
+
+template <typename T>
+void
+MixedRadixPlan<T>::bluestein(T* data)
+{
+    // X[k] = c[k] * sum(x[n] * c[n] * conj(c[k - n])), a convolution computed through the conjugation identity
+    // inverse(conj(a)) = conj(A) / S, so that the last transform is the forward one, giving conj of the convolution
+    const auto inner_size = m_work.size();
+    for (std::size_t n = 0; n < m_size; ++n) {
+        m_work[n] = std::conj(data[n] * m_chirp[n]);
+    }
+    std::fill(m_work.begin() + m_size, m_work.end(), T(0, 0));
+
+    m_inner->stages(m_work.data(), true);
+    for (std::size_t k = 0; k < inner_size; ++k) {
+        m_work[k] = m_work[k] * m_chirp_spectrum[k];
+    }
+    m_inner->stages(m_work.data(), false);
+
+    for (std::size_t k = 0; k < m_size; ++k) {
+        data[k] = m_chirp[k] * std::conj(m_work[k]);
+    }
+}
+
+/**
+ * @brief Get the cached plan of a size, built on the first call for each size
+ *
+ * The plans hold their scratch memory, so each thread has its own cache and never locks. As in window_table(), the
+ * thread also remembers the last plan it got, so repeated calls with the same size do not even search the cache. The
+ * plans live as long as the thread: keep a MixedRadixPlan of your own instead for sizes that are used only for a while.
+ *
+ * @param size The transform size
+ * @tparam T The complex number type
+ * @return The plan
+ */
+template <typename T = Complex>
+MixedRadixPlan<T>&
+mixed_radix_plan(std::size_t size)
+{
+    thread_local std::size_t        last_size = 0;
+    thread_local MixedRadixPlan<T>* last_plan = nullptr;
+    if (last_plan != nullptr && last_size == size) {
+        return *last_plan;
+    }
+
+    thread_local std::map<std::size_t, std::unique_ptr<MixedRadixPlan<T>>> plans;
+    auto& plan = plans[size];
+    if (!plan) {
+        plan = std::make_unique<MixedRadixPlan<T>>(size);
+    }
+    last_size = size;
+    last_plan = plan.get();
+    return *plan;
+}
+
+}  // namespace fftemb
+
+#endif  // H_FFT_MIXED_RADIX_HPP
@@ -0,0 +1,589 @@
+/**
+ * @file fft_pipeline.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the FftPipeline class, from the acquisition of the samples to their peaks
+ */
+
+#ifndef H_FFT_PIPELINE_HPP
+#define H_FFT_PIPELINE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+#include "etl/vector.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "ingest.hpp"
+#include "peak_detector.hpp"
+#include "spsc_queue.hpp"
+#include "window.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace fftemb
+{
+/// @brief The stages of an FftPipeline, in order, each run by its own worker thread
+enum class PipelineStage
+{
+    /// @brief The conversion of the integer samples, with the DC removal
+    ingest,
+    /// @brief The multiplication by the window
+    window,
+    /// @brief The transform
+    fft,
+    /// @brief The detection of the largest peaks
+    peaks
+};
+
+/// @brief The number of stages of an FftPipeline
+inline constexpr std::size_t k_pipeline_stages = 4;
+
+/// @brief The names of the stages, indexed by PipelineStage
+inline constexpr std::array<const char*, k_pipeline_stages> k_pipeline_stage_names{"ingest", "window", "fft", "peaks"};
+
+/// @brief The number of empty polls of a queue by a worker before it yields its CPU, and then before it sleeps
+inline constexpr unsigned k_pipeline_spins = 256;
+
+/// @brief The first sleep of an idle worker, doubled on every empty poll up to PipelineOptions::idle_sleep
+inline constexpr std::chrono::microseconds k_pipeline_first_sleep{1};
+
+/**
+ * @brief Histogram of latencies, with buckets 12.5 % wide from 8 ns up, written by one thread and read by any
+ *
+ * Each power of 2 is split in 8 linear sub-buckets, so any percentile is known within 12.5 % from a few KiB of
+ * counters. The counters are relaxed atomics: recording is a few instructions and never blocks, and the readers get
+ * consistent enough figures while it goes on.
+ */
+class LatencyHistogram
+{
+public:
+    /// @brief The number of sub-buckets of every power of 2, as a number of bits
+    static constexpr std::size_t k_sub_bucket_bits = 3;
+    /// @brief The number of sub-buckets of every power of 2
+    static constexpr std::size_t k_sub_buckets = std::size_t{1} << k_sub_bucket_bits;
+    /// @brief The number of buckets, up to 2^64 ns
+    static constexpr std::size_t k_buckets = (64 - k_sub_bucket_bits + 1) * k_sub_buckets;
+
+    /**
+     * @brief Counts a latency
+     *
+     * @param latency The latency, negative ones counted as 0
+     */
+    void
+    record(std::chrono::nanoseconds latency)
+    {
+        const auto value = static_cast<uint64_t>(std::max<std::chrono::nanoseconds::rep>(latency.count(), 0));
+        m_buckets[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(value, std::memory_order_relaxed);
+        if (value > m_max.load(std::memory_order_relaxed)) {
+            m_max.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Get a percentile of the latencies
+     *
+     * @param fraction The fraction of the latencies at or below the percentile, 0.99 for the p99
+     * @return The upper bound of the bucket of the percentile, at most the largest latency (0 if none was recorded)
+     */
+    std::chrono::nanoseconds
+    percentile(double fraction) const
+    {
+        const auto count = m_count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        const auto share = std::clamp(fraction, 0.0, 1.0) * count;
+        const auto rank  = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(share)));
+        uint64_t   seen  = 0;
+        for (std::size_t index = 0; index < k_buckets; ++index) {
+            seen += m_buckets[index].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::chrono::nanoseconds(std::min(upper_bound(index), m_max.load(std::memory_order_relaxed)));
+            }
+        }
+        return max();
+    }
+
+    /**
+     * @brief Get the number of latencies
+     *
+     * @return The number of recorded latencies
+     */
+    uint64_t
+    count() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the mean latency
+     *
+     * @return The mean of the latencies (0 if none was recorded)
+     */
+    std::chrono::nanoseconds
+    mean() const
+    {
+        const auto count = m_count.load(std::memory_order_relaxed);
+        return std::chrono::nanoseconds(count > 0 ? m_total.load(std::memory_order_relaxed) / count : 0);
+    }
+
+    /**
+     * @brief Get the largest latency
+     *
+     * @return The largest recorded latency
+     */
+    std::chrono::nanoseconds
+    max() const
+    {
+        return std::chrono::nanoseconds(m_max.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Clears the counters, from the writing thread or while it is idle
+     */
+    void
+    reset()
+    {
+        for (auto& bucket : m_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        m_count.store(0, std::memory_order_relaxed);
+        m_total.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the bucket of a latency
+     *
+     * @param value The latency, in ns
+     * @return The index of the bucket: the value itself below 8, then 8 sub-buckets per power of 2
+     */
+    static constexpr std::size_t
+    bucket(uint64_t value)
+    {
+        if (value < k_sub_buckets) {
+            return value;
+        }
+        const auto shift = static_cast<std::size_t>(std::bit_width(value)) - 1 - k_sub_bucket_bits;
+        return k_sub_buckets * (shift + 1) + ((value >> shift) - k_sub_buckets);
+    }
+
+    /**
+     * @brief Get the largest latency of a bucket
+     *
+     * @param index The index of the bucket
+     * @return The upper bound of the bucket, in ns
+     */
+    static constexpr uint64_t
+    upper_bound(std::size_t index)
+    {
+        if (index < k_sub_buckets) {
+            return index;
+        }
+        const auto shift = index / k_sub_buckets - 1;
+        const auto lower = static_cast<uint64_t>(k_sub_buckets + index % k_sub_buckets) << shift;
+        return lower + ((uint64_t{1} << shift) - 1);
+    }
+
+private:
+    /// @brief The number of latencies of each bucket
+    std::array<std::atomic<uint64_t>, k_buckets> m_buckets{};
+    /// @brief The number of latencies
+    std::atomic<uint64_t> m_count{0};
+    /// @brief The sum of the latencies, in ns
+    std::atomic<uint64_t> m_total{0};
+    /// @brief The largest latency, in ns
+    std::atomic<uint64_t> m_max{0};
+};
+
+/// @brief The parameters of an FftPipeline
+struct PipelineOptions
+{
+    /// @brief The sampling period of the signal, for the frequencies of the peaks
+    std::chrono::nanoseconds sampling_period = std::chrono::microseconds(100);
+    /// @brief The number of bits by which the samples are shifted beyond their full scale, to keep the spectrum within
+    /// the range of the type
+    int headroom_bits = 0;
+    /// @brief Whether the mean of each frame is subtracted
+    bool remove_dc = true;
+    /// @brief The window function, applied with its coherent gain correction
+    WindowType window = WindowType::hann;
+    /// @brief The sub-bin interpolation of the peaks
+    PeakInterpolation interpolation = PeakInterpolation::parabolic;
+    /// @brief The CPU each stage worker is pinned to, indexed by PipelineStage, -1 to leave it to the scheduler
+    std::array<int, k_pipeline_stages> cpus{-1, -1, -1, -1};
+    /// @brief The longest sleep of an idle worker, which bounds the latency added to the first frame after a pause;
+    /// zero keeps the idle workers spinning and yielding, for CPUs dedicated to the pipeline
+    std::chrono::microseconds idle_sleep = std::chrono::microseconds(100);
+};
+
+namespace fft_utils
+{
+/**
+ * @brief Pins a thread to a CPU
+ *
+ * @param thread The thread
+ * @param cpu The index of the CPU
+ * @return Whether the thread was pinned, always false where the affinity cannot be set
+ */
+inline bool
+pin_thread(std::thread& thread, int cpu)
+{
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+    static_cast<void>(thread);
+    static_cast<void>(cpu);
+    return false;
+#endif
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Pipeline from the acquisition of integer samples to the peaks of their spectra, across worker threads
+ *
+ * The frames come from a pool allocated at construction and travel through lock-free SPSC queues: the acquisition
+ * thread submits the samples of a frame, a worker thread per stage takes it through the ingest, the window, the
+ * transform and the peak detection, and a consumer thread polls the finished frames, which go back to the pool. No
+ * step blocks, locks or allocates, and the acquisition thread never waits: without a free frame, the samples are
+ * dropped and counted. Each stage records its latency, from the entry of a frame in its queue to the end of its work,
+ * in a LatencyHistogram, as well as the whole path from the submission. An idle worker polls its queue, then yields
+ * its CPU, then sleeps for increasing periods up to PipelineOptions::idle_sleep.
+ *
+ * @tparam N The frame size (must be a power of 2)
+ * @tparam Sample The integer type of the samples
+ * @tparam T The complex number type
+ * @tparam MaxPeaks The maximum number of peaks of each frame
+ * @tparam Frames The number of frames of the pool (must be a power of 2), the depth of the pipeline
+ */
+template <std::size_t N,
+          typename Sample      = int16_t,
+          typename T           = Complex,
+          std::size_t MaxPeaks = 8,
+          std::size_t Frames   = 16>
+class FftPipeline
+{
+    static_assert(cnl::ispow2(N), "The frame size must be a power of 2");
+
+public:
+    using Real = typename T::value_type;
+
+    /// @brief A frame of the pool
+    struct Frame
+    {
+        /// @brief The samples, as submitted
+        std::array<Sample, N> samples;
+        /// @brief The signal, then its spectrum
+        etl::vector<T, N> spectrum;
+        /// @brief The largest peaks of the spectrum, the largest one first
+        etl::vector<Peak, MaxPeaks> peaks;
+        /// @brief The index of the frame among the accepted ones, from 0
+        uint64_t sequence = 0;
+        /// @brief The time of the submission
+        std::chrono::steady_clock::time_point submitted;
+        /// @brief The time of the entry in the queue of the current stage
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    /**
+     * @brief Construct a new pipeline, allocating the frames and starting the workers
+     *
+     * @param options The parameters of the stages and the CPUs of the workers
+     */
+    explicit FftPipeline(const PipelineOptions& options = {});
+
+    /**
+     * @brief Stops and joins the workers, discarding the frames in flight
+     */
+    ~FftPipeline();
+
+    FftPipeline(const FftPipeline&) = delete;
+    FftPipeline&
+    operator=(const FftPipeline&) = delete;
+
+    /**
+     * @brief Submits the samples of a frame, from the acquisition thread (only one may submit)
+     *
+     * @param samples The samples
+     * @return Whether the frame was accepted, false if the pool was empty and the samples were dropped
+     */
+    bool
+    submit(std::span<const Sample, N> samples);
+
+    /**
+     * @brief Hands every finished frame to a callable, then returns it to the pool, from the consumer thread (only
+     * one may poll)
+     *
+     * @param on_frame The callable invoked with each finished frame (a const Frame&), valid during the call
+     * @return The number of frames
+     */
+    template <typename Callback>
+    std::size_t
+    poll(Callback&& on_frame);
+
+    /**
+     * @brief Get the latencies of a stage
+     *
+     * @param stage The stage
+     * @return The histogram of the times from the entry of each frame in the queue of the stage to the end of its work
+     */
+    const LatencyHistogram&
+    latency(PipelineStage stage) const
+    {
+        return m_latencies[static_cast<std::size_t>(stage)];
+    }
+
+    /**
+     * @brief Get the latencies of the whole pipeline
+     *
+     * @return The histogram of the times from the submission of each frame to the end of its peak detection
+     */
+    const LatencyHistogram&
+    end_to_end_latency() const
+    {
+        return m_end_to_end;
+    }
+
+    /**
+     * @brief Get the number of submitted frames
+     *
+     * @return The number of calls to submit(), accepted or not
+     */
+    uint64_t
+    submitted() const
+    {
+        return m_submitted.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of dropped frames
+     *
+     * @return The number of frames submitted while the pool was empty
+     */
+    uint64_t
+    dropped() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of polled frames
+     *
+     * @return The number of frames handed to the consumer
+     */
+    uint64_t
+    completed() const
+    {
+        return m_completed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get whether the workers run on the requested CPUs
+     *
+     * @return Whether every requested pinning succeeded
+     */
+    bool
+    pinned() const
+    {
+        return m_pinned;
+    }
+
+private:
+    /**
+     * @brief The loop of the worker of a stage
+     *
+     * @param stage The index of the stage
+     */
+    void
+    work(std::size_t stage);
+
+    /**
+     * @brief Runs a stage on a frame
+     *
+     * @param stage The index of the stage
+     * @param frame The frame
+     */
+    void
+    process(std::size_t stage, Frame& frame);
+
+    /// @brief The parameters of the stages
+    PipelineOptions m_options;
+    /// @brief The window coefficients, from the cache of window_table(), looked up once
+    const std::vector<Real>& m_window;
+    /// @brief The frames
+    std::unique_ptr<Frame[]> m_frames;
+    /// @brief The free frames, from the consumer to the acquisition thread
+    SpscQueue<uint32_t, Frames> m_free;
+    /// @brief The input queue of each stage, then the finished frames
+    std::array<SpscQueue<uint32_t, Frames>, k_pipeline_stages + 1> m_queues;
+    /// @brief The latencies of each stage
+    std::array<LatencyHistogram, k_pipeline_stages> m_latencies;
+    /// @brief The latencies from the submission to the end of the last stage
+    LatencyHistogram m_end_to_end;
+    /// @brief The number of calls to submit()
+    std::atomic<uint64_t> m_submitted{0};
+    /// @brief The number of dropped frames
+    std::atomic<uint64_t> m_dropped{0};
+    /// @brief The number of polled frames
+    std::atomic<uint64_t> m_completed{0};
+    /// @brief The index of the next accepted frame
+    uint64_t m_sequence = 0;
+    /// @brief Whether every requested pinning succeeded
+    bool m_pinned = true;
+    /// @brief Whether the workers must exit
+    std::atomic<bool> m_stop{false};
+    /// @brief The worker of each stage
+    std::array<std::thread, k_pipeline_stages> m_workers;
+};
+
+template <std::size_t N, typename Sample, typename T, std::size_t MaxPeaks, std::size_t Frames>
+FftPipeline<N, Sample, T, MaxPeaks, Frames>::FftPipeline(const PipelineOptions& options)
+  : m_options(options), m_window(window_table<Real>(options.window, N)), m_frames(std::make_unique<Frame[]>(Frames))
+{
+    for (uint32_t index = 0; index < Frames; ++index) {
+        m_frames[index].spectrum.resize(N);
+        m_free.try_push(index);
+    }
+    for (std::size_t stage = 0; stage < k_pipeline_stages; ++stage) {
+        m_workers[stage] = std::thread(&FftPipeline::work, this, stage);
+        if (options.cpus[stage] >= 0) {
+            m_pinned = fft_utils::pin_thread(m_workers[stage], options.cpus[stage]) && m_pinned;
+        }
+    }
+}
+
+template <std::size_t N, typename Sample, typename T, std::size_t MaxPeaks, std::size_t Frames>
+FftPipeline<N, Sample, T, MaxPeaks, Frames>::~FftPipeline()
+{
+    m_stop.store(true, std::memory_order_release);
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+template <std::size_t N, typename Sample, typename T, std::size_t MaxPeaks, std::size_t Frames>
+bool
+FftPipeline<N, Sample, T, MaxPeaks, Frames>::submit(std::span<const Sample, N> samples)
+{
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+    uint32_t index;
+    if (!m_free.try_pop(index)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    auto& frame = m_frames[index];
+    std::copy(samples.begin(), samples.end(), frame.samples.begin());
+    frame.sequence  = m_sequence++;
+    frame.submitted = std::chrono::steady_clock::now();
+    frame.enqueued  = frame.submitted;
+    // every queue holds the whole pool, so the frame always fits
+    m_queues[0].try_push(index);
+    return true;
+}
+
+template <std::size_t N, typename Sample, typename T, std::size_t MaxPeaks, std::size_t Frames>
+template <typename Callback>
+std::size_t
+FftPipeline<N, Sample, T, MaxPeaks, Frames>::poll(Callback&& on_frame)
+{
+    std::size_t count = 0;
+    uint32_t    index;
+    while (m_queues[k_pipeline_stages].try_pop(index)) {
+        on_frame(static_cast<const Frame&>(m_frames[index]));
+        m_free.try_push(index);
+        ++count;
+    }
+    m_completed.fetch_add(count, std::memory_order_relaxed);
+    return count;
+}
+
+template <std::size_t N, typename Sample, typename T, std::size_t MaxPeaks, std::size_t Frames>
+void
+FftPipeline<N, Sample, T, MaxPeaks, Frames>::work(std::size_t stage)
+{
+    auto&    input  = m_queues[stage];
+    auto&    output = m_queues[stage + 1];
+    unsigned idle   = 0;
+    auto     sleep  = k_pipeline_first_sleep;
+    uint32_t index;
+    while (!m_stop.load(std::memory_order_acquire)) {
+        if (!input.try_pop(index)) {
+            if (idle < 2 * k_pipeline_spins) {
+                if (++idle >= k_pipeline_spins) {
+                    std::this_thread::yield();
+                }
+            }
+            else if (m_options.idle_sleep > std::chrono::microseconds::zero()) {
+                std::this_thread::sleep_for(sleep);
+                sleep = std::min(2 * sleep, m_options.idle_sleep);
+            }
+            else {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        idle  = 0;
+        sleep = k_pipeline_first_sleep;
+
+        auto& frame = m_frames[index];
+        process(stage, frame);
+        const auto now = std::chrono::steady_clock::now();
+        m_latencies[stage].record(now - frame.enqueued);
+        if (stage == k_pipeline_stages - 1) {
+            m_end_to_end.record(now - frame.submitted);
+        }
+        frame.enqueued = now;
+        output.try_push(index);
+    }
+}
+
+template <std::size_t N, typename Sample, typename T, std::size_t MaxPeaks, std::size_t Frames>
+void
+FftPipeline<N, Sample, T, MaxPeaks, Frames>::process(std::size_t stage, Frame& frame)
+{
+    auto& spectrum = static_cast<etl::ivector<T>&>(frame.spectrum);
+    switch (static_cast<PipelineStage>(stage)) {
+    case PipelineStage::ingest:
+        fft_utils::ingest(std::span<const Sample, N>(frame.samples),
+                          spectrum,
+                          fft_utils::k_full_scale_shift<Sample> + m_options.headroom_bits,
+                          m_options.remove_dc);
+        break;
+    case PipelineStage::window:
+        for (std::size_t i = 0; i < N; ++i) {
+            spectrum[i] = spectrum[i] * m_window[i];
+        }
+        break;
+    case PipelineStage::fft:
+        compute(spectrum);
+        break;
+    default:
+        frame.peaks = find_peaks<MaxPeaks>(
+            static_cast<const etl::ivector<T>&>(spectrum), m_options.sampling_period, m_options.interpolation);
+        break;
+    }
+}
+
+}  // namespace fftemb
+
+#endif  // H_FFT_PIPELINE_HPP
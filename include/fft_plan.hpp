@@ -0,0 +1,228 @@
+/**
+ * @file fft_plan.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the FftPlan class
+ */
+
+#ifndef H_FFT_PLAN_HPP
+#define H_FFT_PLAN_HPP
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include "etl/vector.h"
+#include "fft_types.hpp"
+
+namespace fftemb
+{
+/**
+ * @brief Reusable FFT of a fixed size, with the twiddle factors and the bit reversal permutation computed once
+ *
+ * @tparam N The transform size (must be a power of 2)
+ * @tparam T The complex number type
+ */
+template <std::size_t N, typename T = Complex>
+class FftPlan
+{
+    static_assert(cnl::ispow2(N), "The transform size must be a power of 2");
+
+public:
+    /**
+     * @brief Construct a new FFT plan, building the twiddle and bit reversal tables
+     */
+    FftPlan();
+
+    /**
+     * @brief Computes the in-place FFT transform using the precomputed tables
+     *
+     * @param[in,out] signal The signal to be transformed, with exactly N elements
+     */
+    template <template <class...> class Container>
+    void
+    execute(Container<T>& signal) const;
+
+    /**
+     * @brief Computes the in-place FFT transform of the windowed signal, multiplying by the window while permuting
+     *
+     * @param[in,out] signal The signal to be transformed, with exactly N elements
+     * @param window The window coefficients, such as the ones of window_table()
+     */
+    template <template <class...> class Container>
+    void
+    execute(Container<T>& signal, const std::array<typename T::value_type, N>& window) const;
+
+    /**
+     * @brief Computes the butterfly stages of a signal already in bit reversed order
+     *
+     * @param[in,out] signal The bit reversed signal, with exactly N elements
+     */
+    template <template <class...> class Container>
+    void
+    butterflies(Container<T>& signal) const;
+
+    /**
+     * @brief Computes the in-place inverse FFT transform, sharing the twiddle and bit reversal tables
+     *
+     * Each stage halves its outputs, which scales the result by 1/N without ever growing the magnitudes, so a
+     * spectrum computed by execute() is turned back into its signal without overflow.
+     *
+     * @param[in,out] spectrum The spectrum to be transformed, with exactly N elements
+     */
+    template <template <class...> class Container>
+    void
+    execute_inverse(Container<T>& spectrum) const;
+
+    /**
+     * @brief Computes the halving butterfly stages of the inverse transform of a spectrum already in bit reversed order
+     *
+     * @param[in,out] spectrum The bit reversed spectrum, with exactly N elements
+     */
+    template <template <class...> class Container>
+    void
+    inverse_butterflies(Container<T>& spectrum) const;
+
+    /**
+     * @brief Get the transform size
+     *
+     * @return The number of points of the transform
+     */
+    static constexpr std::size_t
+    size()
+    {
+        return N;
+    }
+
+    /**
+     * @brief Get the twiddle table
+     *
+     * @return The twiddle factors e^(2πik/N), for k in [0, N/2)
+     */
+    const std::array<T, N / 2>&
+    twiddles() const
+    {
+        return m_twiddles;
+    }
+
+    /**
+     * @brief Get the bit reversal table
+     *
+     * @return The bit reversed index of every position in [0, N)
+     */
+    const std::array<uint32_t, N>&
+    bit_reversed_indices() const
+    {
+        return m_bit_reversed;
+    }
+
+private:
+    /// @brief The twiddle factors of the last stage, shared by all the previous ones through a stride
+    std::array<T, N / 2> m_twiddles;
+    /// @brief The bit reversal permutation
+    std::array<uint32_t, N> m_bit_reversed;
+};
+
+template <std::size_t N, typename T>
+FftPlan<N, T>::FftPlan()
+{
+    for (std::size_t k = 0; k < N / 2; ++k) {
+        const auto angle = 2 * std::numbers::pi * k / N;
+        m_twiddles[k]    = T(std::cos(angle), std::sin(angle));
+    }
+
+    // every index is the reversed index of its half shifted by one, plus the reversed lowest bit
+    m_bit_reversed[0] = 0;
+    for (std::size_t i = 1; i < N; ++i) {
+        m_bit_reversed[i] = (m_bit_reversed[i >> 1] >> 1) | ((i & 1) * (N >> 1));
+    }
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+void
+FftPlan<N, T>::execute(Container<T>& signal) const
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto j = m_bit_reversed[i];
+        if (j > i) {
+            std::swap(signal[i], signal[j]);
+        }
+    }
+    butterflies(signal);
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+void
+FftPlan<N, T>::execute(Container<T>& signal, const std::array<typename T::value_type, N>& window) const
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto j = m_bit_reversed[i];
+        if (j > i) {
+            const auto sample = signal[i];
+            signal[i]         = signal[j] * window[j];
+            signal[j]         = sample * window[i];
+        }
+        else if (j == i) {
+            signal[i] = signal[i] * window[i];
+        }
+    }
+    butterflies(signal);
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+void
+FftPlan<N, T>::butterflies(Container<T>& signal) const
+{
+    for (std::size_t len = 2, stride = N / 2; len <= N; len <<= 1, stride >>= 1) {
+        const auto half = len / 2;
+        for (std::size_t i = 0; i < N; i += len) {
+            for (std::size_t j = 0; j < half; ++j) {
+                auto u               = signal[i + j];
+                auto v               = m_twiddles[j * stride] * signal[i + j + half];
+                signal[i + j]        = u + v;
+                signal[i + j + half] = u - v;
+            }
+        }
+    }
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+void
+FftPlan<N, T>::execute_inverse(Container<T>& spectrum) const
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto j = m_bit_reversed[i];
+        if (j > i) {
+            std::swap(spectrum[i], spectrum[j]);
+        }
+    }
+    inverse_butterflies(spectrum);
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+void
+FftPlan<N, T>::inverse_butterflies(Container<T>& spectrum) const
+{
+    const typename T::value_type half{0.5};
+    for (std::size_t len = 2, stride = N / 2; len <= N; len <<= 1, stride >>= 1) {
+        const auto half_len = len / 2;
+        for (std::size_t i = 0; i < N; i += len) {
+            for (std::size_t j = 0; j < half_len; ++j) {
+                // the inverse twiddle factors are the conjugates of the forward ones
+                auto u                     = spectrum[i + j] * half;
+                auto v                     = std::conj(m_twiddles[j * stride]) * spectrum[i + j + half_len] * half;
+                spectrum[i + j]            = u + v;
+                spectrum[i + j + half_len] = u - v;
+            }
+        }
+    }
+}
+
+}  // namespace fftemb
+
+#endif  // H_FFT_PLAN_HPP
@@ -0,0 +1,148 @@
+/**
+ * @file fft_pruned.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the PrunedFft class
+ */
+
+#ifndef H_FFT_PRUNED_HPP
+#define H_FFT_PRUNED_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+
+namespace fftemb
+{
+/**
+ * @brief Output-pruned FFT, computing only a band of consecutive bins
+ *
+ * The butterflies are the ones of FftPlan, from a bit reversed signal. The stage of length L holds N/L transforms of L
+ * points, and the bin k of the result only reads the bin k mod L of each of them. So once a band of C bins is narrower
+ * than half a stage, each of its blocks computes only the C outputs the band reads, at one complex multiply each,
+ * instead of the L/2 butterflies. The work falls from (N/2) log2(N) complex multiplies to about (N/2) log2(2C) + N.
+ *
+ * @tparam N The transform size (must be a power of 2)
+ * @tparam T The complex number type
+ */
+template <std::size_t N, typename T = Complex>
+class PrunedFft
+{
+public:
+    /**
+     * @brief Construct a new pruned FFT of a band of bins
+     *
+     * @param first The first bin of the band, wrapped to [0, N)
+     * @param count The number of bins of the band, wrapping past N - 1 to 0, clamped to [1, N]
+     */
+    PrunedFft(std::size_t first, std::size_t count);
+
+    /**
+     * @brief Computes the bins of the band of the in-place FFT transform
+     *
+     * The bins of the band land on their own indices, equal to the ones of FftPlan::execute(). The other elements
+     * are left with partial results.
+     *
+     * @param[in,out] signal The signal to be transformed, with exactly N elements
+     */
+    template <template <class...> class Container>
+    void
+    execute(Container<T>& signal) const;
+
+    /**
+     * @brief Get the first bin of the band
+     *
+     * @return The index of the first bin
+     */
+    std::size_t
+    first() const
+    {
+        return m_first;
+    }
+
+    /**
+     * @brief Get the number of bins of the band
+     *
+     * @return The number of bins
+     */
+    std::size_t
+    count() const
+    {
+        return m_count;
+    }
+
+    /**
+     * @brief Get the number of complex multiplies of a transform, N/2 per full stage and C per block of a pruned one
+     *
+     * @return The number of multiplies, (N/2) log2(N) for the whole spectrum
+     */
+    std::size_t
+    multiplies() const
+    {
+        std::size_t total = 0;
+        for (std::size_t len = 2; len <= N; len <<= 1) {
+            total += m_count > len / 2 ? N / 2 : N / len * m_count;
+        }
+        return total;
+    }
+
+private:
+    /// @brief The twiddle factors and the bit reversal table
+    FftPlan<N, T> m_plan;
+    /// @brief The first bin of the band
+    std::size_t m_first;
+    /// @brief The number of bins of the band
+    std::size_t m_count;
+};
+
+template <std::size_t N, typename T>
+PrunedFft<N, T>::PrunedFft(std::size_t first, std::size_t count)
+  : m_first(first % N), m_count(std::clamp<std::size_t>(count, 1, N))
+{
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+void
+PrunedFft<N, T>::execute(Container<T>& signal) const
+{
+    const auto& bit_reversed = m_plan.bit_reversed_indices();
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto j = bit_reversed[i];
+        if (j > i) {
+            std::swap(signal[i], signal[j]);
+        }
+    }
+
+    const auto& twiddles = m_plan.twiddles();
+    for (std::size_t len = 2, stride = N / 2; len <= N; len <<= 1, stride >>= 1) {
+        const auto half = len / 2;
+        if (m_count > half) {
+            for (std::size_t i = 0; i < N; i += len) {
+                for (std::size_t j = 0; j < half; ++j) {
+                    auto u               = signal[i + j];
+                    auto v               = twiddles[j * stride] * signal[i + j + half];
+                    signal[i + j]        = u + v;
+                    signal[i + j + half] = u - v;
+                }
+            }
+            continue;
+        }
+        // a band of at most L/2 bins never holds both k and k + L/2, so every output overwrites its own input
+        const auto start = m_first & (len - 1);
+        for (std::size_t i = 0; i < N; i += len) {
+            for (std::size_t t = 0; t < m_count; ++t) {
+                const auto k  = (start + t) & (len - 1);
+                const auto j  = k & (half - 1);
+                auto       u  = signal[i + j];
+                auto       v  = twiddles[j * stride] * signal[i + j + half];
+                signal[i + k] = k < half ? u + v : u - v;
+            }
+        }
+    }
+}
+
+}  // namespace fftemb
+
+#endif  // H_FFT_PRUNED_HPP
@@ -0,0 +1,433 @@
+/**
+ * @file fft_simd.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the SIMD radix-2 FFT engine working on raw Q11.20 integers
+ */
+
+#ifndef H_FFT_SIMD_HPP
+#define H_FFT_SIMD_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+#include "fft_tables.hpp"
+#include "fft_types.hpp"
+#include "instrumentation.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FFTEMB_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define FFTEMB_SIMD_X86 0
+#endif
+
+namespace fftemb::simd
+{
+/// @brief The number of fractional bits of the Q11.20 format of Complex and FastComplex
+inline constexpr int k_fraction_bits = 20;
+/// @brief The largest raw value of the 31-bit elastic integer (its range is symmetric)
+inline constexpr int32_t k_raw_max = std::numeric_limits<int32_t>::max();
+/// @brief The smallest raw value of the 31-bit elastic integer
+inline constexpr int32_t k_raw_min = -k_raw_max;
+/// @brief The number of twiddle factors generated at a time, kept on the stack
+inline constexpr std::size_t k_twiddle_chunk = 256;
+
+/// @brief Whether a complex type can be viewed as interleaved pairs of raw Q11.20 integers
+template <typename T>
+inline constexpr bool k_is_q20_layout = (std::is_same_v<T, Complex> || std::is_same_v<T, FastComplex>)
+                                        && sizeof(T) == 2 * sizeof(int32_t) && std::is_standard_layout_v<T>
+                                        && std::is_trivially_copyable_v<T>;
+
+/// @brief The instruction sets the engine can run on
+enum class Isa
+{
+    /// @brief Portable scalar code
+    scalar,
+    /// @brief SSE4.1, 2 complex numbers per vector
+    sse41,
+    /// @brief AVX2, 4 complex numbers per vector
+    avx2
+};
+
+/**
+ * @brief Detects the best instruction set supported by the running CPU
+ *
+ * @return The instruction set
+ */
+inline Isa
+detect_isa()
+{
+#if FFTEMB_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return Isa::sse41;
+    }
+#endif
+    return Isa::scalar;
+}
+
+/**
+ * @brief Get the instruction set used by compute(), detected once
+ *
+ * @return The instruction set
+ */
+inline Isa
+active_isa()
+{
+    static const Isa isa = detect_isa();
+    return isa;
+}
+
+/**
+ * @brief Clamps a wide value to the range of the 31-bit elastic integer, as its overflow check would
+ *
+ * @param value The value
+ * @return The saturated value
+ */
+inline int32_t
+saturate(int64_t value)
+{
+    return static_cast<int32_t>(std::clamp<int64_t>(value, k_raw_min, k_raw_max));
+}
+
+/**
+ * @brief Narrows a Q22.40 product to Q11.20, rounding half away from zero and saturating
+ *
+ * @param value The product
+ * @return The narrowed value
+ */
+inline int32_t
+narrow_product(int64_t value)
+{
+    constexpr int64_t half = int64_t{1} << (k_fraction_bits - 1);
+    return saturate((value + half - (value < 0)) >> k_fraction_bits);
+}
+
+/**
+ * @brief Converts a double to a raw Q11.20 value, rounding half away from zero
+ *
+ * @param value The value
+ * @return The raw value
+ */
+inline int32_t
+to_q20(double value)
+{
+    constexpr double scale = 1 << k_fraction_bits;
+    return saturate(static_cast<int64_t>(value * scale + std::copysign(0.5, value)));
+}
+
+/**
+ * @brief Computes radix-2 butterflies over contiguous runs, with portable code
+ *
+ * @param[in,out] top The interleaved upper inputs, replaced by top + w * bottom
+ * @param[in,out] bottom The interleaved lower inputs, replaced by top - w * bottom
+ * @param twiddles The interleaved twiddle factors w
+ * @param count The number of butterflies
+ */
+inline void
+butterflies_scalar(int32_t* top, int32_t* bottom, const int32_t* twiddles, std::size_t count)
+{
+    for (std::size_t j = 0; j < count; ++j) {
+        const int64_t wr = twiddles[2 * j];
+        const int64_t wi = twiddles[2 * j + 1];
+        const int64_t br = bottom[2 * j];
+        const int64_t bi = bottom[2 * j + 1];
+        const int64_t vr = narrow_product(wr * br - wi * bi);
+        const int64_t vi = narrow_product(wr * bi + wi * br);
+        const int64_t ur = top[2 * j];
+        const int64_t ui = top[2 * j + 1];
+
+        top[2 * j]        = saturate(ur + vr);
+        top[2 * j + 1]    = saturate(ui + vi);
+        bottom[2 * j]     = saturate(ur - vr);
+        bottom[2 * j + 1] = saturate(ui - vi);
+    }
+}
+
+#if FFTEMB_SIMD_X86
+/**
+ * @brief Narrows the Q22.40 products in the 64-bit lanes to Q11.20 in their low 32 bits (SSE4.1)
+ */
+__attribute__((target("sse4.1"))) inline __m128i
+narrow_products_sse41(__m128i value)
+{
+    const auto sign    = _mm_shuffle_epi32(_mm_srai_epi32(value, 31), _MM_SHUFFLE(3, 3, 1, 1));
+    const auto rounded = _mm_add_epi64(value, _mm_add_epi64(_mm_set1_epi64x(1 << (k_fraction_bits - 1)), sign));
+    // the result fits in 32 bits only when the bits from the 51st up are copies of the sign
+    const auto fits      = _mm_cmpeq_epi32(_mm_srai_epi32(rounded, 31), _mm_srai_epi32(rounded, k_fraction_bits - 1));
+    const auto saturated = _mm_xor_si128(_mm_srai_epi32(rounded, 31), _mm_set1_epi32(k_raw_max));
+    const auto shifted   = _mm_srli_epi64(rounded, k_fraction_bits);
+    const auto narrowed  = _mm_blendv_epi8(_mm_shuffle_epi32(saturated, _MM_SHUFFLE(3, 3, 1, 1)),
+                                          shifted,
+                                          _mm_shuffle_epi32(fits, _MM_SHUFFLE(3, 3, 1, 1)));
+    return _mm_max_epi32(narrowed, _mm_set1_epi32(k_raw_min));
+}
+
+/**
+ * @brief Adds or subtracts 32-bit lanes, saturating to the range of the 31-bit elastic integer (SSE4.1)
+ */
+template <bool Subtract>
+__attribute__((target("sse4.1"))) inline __m128i
+saturating_add_sse41(__m128i a, __m128i b)
+{
+    const auto result   = Subtract ? _mm_sub_epi32(a, b) : _mm_add_epi32(a, b);
+    const auto overflow = Subtract ? _mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, result))
+                                   : _mm_and_si128(_mm_xor_si128(a, result), _mm_xor_si128(b, result));
+    const auto saturated = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(k_raw_max));
+    return _mm_max_epi32(_mm_blendv_epi8(result, saturated, _mm_srai_epi32(overflow, 31)), _mm_set1_epi32(k_raw_min));
+}
+
+/**
+ * @brief Computes radix-2 butterflies over contiguous runs, 2 at a time with SSE4.1
+ *
+ * @param[in,out] top The interleaved upper inputs, replaced by top + w * bottom
+ * @param[in,out] bottom The interleaved lower inputs, replaced by top - w * bottom
+ * @param twiddles The interleaved twiddle factors w
+ * @param count The number of butterflies
+ */
+__attribute__((target("sse4.1"))) inline void
+butterflies_sse41(int32_t* top, int32_t* bottom, const int32_t* twiddles, std::size_t count)
+{
+    std::size_t j = 0;
+    for (; j + 2 <= count; j += 2) {
+        const auto w  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(twiddles + 2 * j));
+        const auto b  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + 2 * j));
+        const auto u  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + 2 * j));
+        const auto wi = _mm_srli_epi64(w, 32);
+        const auto bi = _mm_srli_epi64(b, 32);
+
+        const auto vr = narrow_products_sse41(_mm_sub_epi64(_mm_mul_epi32(w, b), _mm_mul_epi32(wi, bi)));
+        const auto vi = narrow_products_sse41(_mm_add_epi64(_mm_mul_epi32(w, bi), _mm_mul_epi32(wi, b)));
+        const auto v  = _mm_blend_epi16(vr, _mm_slli_epi64(vi, 32), 0xCC);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(top + 2 * j), saturating_add_sse41<false>(u, v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bottom + 2 * j), saturating_add_sse41<true>(u, v));
+    }
+    butterflies_scalar(top + 2 * j, bottom + 2 * j, twiddles + 2 * j, count - j);
+}
+
+/**
+ * @brief Narrows the Q22.40 products in the 64-bit lanes to Q11.20 in their low 32 bits (AVX2)
+ */
+__attribute__((target("avx2"))) inline __m256i
+narrow_products_avx2(__m256i value)
+{
+    const auto sign    = _mm256_shuffle_epi32(_mm256_srai_epi32(value, 31), _MM_SHUFFLE(3, 3, 1, 1));
+    const auto rounded = _mm256_add_epi64(value, _mm256_add_epi64(_mm256_set1_epi64x(1 << (k_fraction_bits - 1)), sign));
+    const auto fits
+        = _mm256_cmpeq_epi32(_mm256_srai_epi32(rounded, 31), _mm256_srai_epi32(rounded, k_fraction_bits - 1));
+    const auto saturated = _mm256_xor_si256(_mm256_srai_epi32(rounded, 31), _mm256_set1_epi32(k_raw_max));
+    const auto shifted   = _mm256_srli_epi64(rounded, k_fraction_bits);
+    const auto narrowed  = _mm256_blendv_epi8(_mm256_shuffle_epi32(saturated, _MM_SHUFFLE(3, 3, 1, 1)),
+                                             shifted,
+                                             _mm256_shuffle_epi32(fits, _MM_SHUFFLE(3, 3, 1, 1)));
+    return _mm256_max_epi32(narrowed, _mm256_set1_epi32(k_raw_min));
+}
+
+/**
+ * @brief Adds or subtracts 32-bit lanes, saturating to the range of the 31-bit elastic integer (AVX2)
+ */
+template <bool Subtract>
+__attribute__((target("avx2"))) inline __m256i
+saturating_add_avx2(__m256i a, __m256i b)
+{
+    const auto result   = Subtract ? _mm256_sub_epi32(a, b) : _mm256_add_epi32(a, b);
+    const auto overflow = Subtract ? _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, result))
+                                   : _mm256_and_si256(_mm256_xor_si256(a, result), _mm256_xor_si256(b, result));
+    const auto saturated = _mm256_xor_si256(_mm256_srai_epi32(a, 31), _mm256_set1_epi32(k_raw_max));
+    return _mm256_max_epi32(_mm256_blendv_epi8(result, saturated, _mm256_srai_epi32(overflow, 31)),
+                            _mm256_set1_epi32(k_raw_min));
+}
+
+/**
+ * @brief Computes radix-2 butterflies over contiguous runs, 4 at a time with AVX2
+ *
+ * @param[in,out] top The interleaved upper inputs, replaced by top + w * bottom
+ * @param[in,out] bottom The interleaved lower inputs, replaced by top - w * bottom
+ * @param twiddles The interleaved twiddle factors w
+ * @param count The number of butterflies
+ */
+__attribute__((target("avx2"))) inline void
+butterflies_avx2(int32_t* top, int32_t* bottom, const int32_t* twiddles, std::size_t count)
+{
+    std::size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        const auto w  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(twiddles + 2 * j));
+        const auto b  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bottom + 2 * j));
+        const auto u  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(top + 2 * j));
+        const auto wi = _mm256_srli_epi64(w, 32);
+        const auto bi = _mm256_srli_epi64(b, 32);
+
+        const auto vr = narrow_products_avx2(_mm256_sub_epi64(_mm256_mul_epi32(w, b), _mm256_mul_epi32(wi, bi)));
+        const auto vi = narrow_products_avx2(_mm256_add_epi64(_mm256_mul_epi32(w, bi), _mm256_mul_epi32(wi, b)));
+        const auto v  = _mm256_blend_epi16(vr, _mm256_slli_epi64(vi, 32), 0xCC);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(top + 2 * j), saturating_add_avx2<false>(u, v));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(bottom + 2 * j), saturating_add_avx2<true>(u, v));
+    }
+    butterflies_sse41(top + 2 * j, bottom + 2 * j, twiddles + 2 * j, count - j);
+}
+#endif
+
+/**
+ * @brief Computes radix-2 butterflies over contiguous runs with the given instruction set
+ *
+ * @param[in,out] top The interleaved upper inputs, replaced by top + w * bottom
+ * @param[in,out] bottom The interleaved lower inputs, replaced by top - w * bottom
+ * @param twiddles The interleaved twiddle factors w
+ * @param count The number of butterflies
+ * @param isa The instruction set
+ */
+inline void
+butterflies(int32_t* top, int32_t* bottom, const int32_t* twiddles, std::size_t count, Isa isa)
+{
+#if FFTEMB_SIMD_X86
+    if (isa == Isa::avx2) {
+        return butterflies_avx2(top, bottom, twiddles, count);
+    }
+    if (isa == Isa::sse41) {
+        return butterflies_sse41(top, bottom, twiddles, count);
+    }
+#endif
+    butterflies_scalar(top, bottom, twiddles, count);
+}
+
+/**
+ * @brief Fills a run of twiddle factors e^(2πij/len) of a stage
+ *
+ * The first factor of the run is evaluated directly and the next ones through a double precision recurrence, so
+ * the trigonometry is amortized over the run without fixed-point error accumulation.
+ *
+ * @param[out] twiddles The interleaved raw twiddle factors
+ * @param len The length of the stage
+ * @param first The index j of the first factor
+ * @param count The number of factors
+ */
+inline void
+fill_twiddles(int32_t* twiddles, std::size_t len, std::size_t first, std::size_t count)
+{
+    const auto step = std::polar(1.0, 2 * std::numbers::pi / len);
+    const auto w    = std::polar(1.0, 2 * std::numbers::pi * first / len);
+    // spelled out, since the complex product of the standard library also handles infinities and NaNs
+    double wr = w.real();
+    double wi = w.imag();
+    for (std::size_t j = 0; j < count; ++j) {
+        twiddles[2 * j]     = to_q20(wr);
+        twiddles[2 * j + 1] = to_q20(wi);
+        const auto next_wr  = wr * step.real() - wi * step.imag();
+        wi                  = wr * step.imag() + wi * step.real();
+        wr                  = next_wr;
+    }
+}
+
+/**
+ * @brief Multiplies raw Q11.20 complex numbers by the successive powers of a unit root, w^0, w^1, w^2...
+ *
+ * @param[in,out] data The interleaved real and imaginary parts, 2 * count integers
+ * @param count The number of complex numbers
+ * @param angle The angle of the unit root w
+ */
+inline void
+multiply_by_powers(int32_t* data, std::size_t count, double angle)
+{
+    const auto step = std::polar(1.0, angle);
+    double     wr   = 1;
+    double     wi   = 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        const int64_t tr     = to_q20(wr);
+        const int64_t ti     = to_q20(wi);
+        const int64_t br     = data[2 * k];
+        const int64_t bi     = data[2 * k + 1];
+        data[2 * k]          = narrow_product(tr * br - ti * bi);
+        data[2 * k + 1]      = narrow_product(tr * bi + ti * br);
+        const auto next_wr   = wr * step.real() - wi * step.imag();
+        wi                   = wr * step.imag() + wi * step.real();
+        wr                   = next_wr;
+    }
+}
+
+/**
+ * @brief Computes the first two radix-2 stages of bit reversed raw Q11.20 data, whose twiddle factors are 1 and i
+ *
+ * Multiplying by 1 or i is exact, so these stages only add, subtract and swap components.
+ *
+ * @param[in,out] data The interleaved real and imaginary parts, 2n integers
+ * @param n The transform size (must be a power of 2)
+ */
+inline void
+first_stages(int32_t* data, std::size_t n)
+{
+    if (n >= 2) {
+        for (std::size_t i = 0; i < 2 * n; i += 4) {
+            const int64_t ur = data[i], ui = data[i + 1], vr = data[i + 2], vi = data[i + 3];
+            data[i]          = saturate(ur + vr);
+            data[i + 1]      = saturate(ui + vi);
+            data[i + 2]      = saturate(ur - vr);
+            data[i + 3]      = saturate(ui - vi);
+        }
+    }
+    if (n >= 4) {
+        for (std::size_t i = 0; i < 2 * n; i += 8) {
+            for (std::size_t j = 0; j < 2; ++j) {
+                int32_t* u  = data + i + 2 * j;
+                int32_t* v  = u + 4;
+                int64_t  vr = v[0];
+                int64_t  vi = v[1];
+                if (j == 1) {
+                    vr = -int64_t{v[1]};
+                    vi = v[0];
+                }
+                const int64_t ur = u[0], ui = u[1];
+                u[0]             = saturate(ur + vr);
+                u[1]             = saturate(ui + vi);
+                v[0]             = saturate(ur - vr);
+                v[1]             = saturate(ui - vi);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes the in-place radix-2 FFT of interleaved raw Q11.20 complex numbers
+ *
+ * @param[in,out] data The interleaved real and imaginary parts, 2n integers
+ * @param n The transform size (must be a power of 2)
+ * @param isa The instruction set
+ */
+inline void
+transform_q20(int32_t* data, std::size_t n, Isa isa = active_isa())
+{
+    // each complex number moves as a whole, as a pair of integers
+    fft_utils::permute_bit_reversed(reinterpret_cast<std::array<int32_t, 2>*>(data), n);
+
+    FFTEMB_STAGE_BEGIN(fused);
+    first_stages(data, n);
+    // the two fused stages are recorded as the second one
+    FFTEMB_STAGE_END(fused, 1, data, 2 * n);
+
+    int32_t twiddles[2 * k_twiddle_chunk];
+    for (std::size_t len = 8, stage = 2; len <= n; len <<= 1, ++stage) {
+        FFTEMB_STAGE_BEGIN(start);
+        const auto half = len / 2;
+        for (std::size_t first = 0; first < half; first += k_twiddle_chunk) {
+            const auto count = std::min(k_twiddle_chunk, half - first);
+            fill_twiddles(twiddles, len, first, count);
+            for (std::size_t i = 0; i < n; i += len) {
+                butterflies(data + 2 * (i + first), data + 2 * (i + first + half), twiddles, count, isa);
+            }
+        }
+        FFTEMB_STAGE_END(start, stage, data, 2 * n);
+    }
+}
+
+}  // namespace fftemb::simd
+
+#endif  // H_FFT_SIMD_HPP
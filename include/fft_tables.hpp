@@ -0,0 +1,266 @@
+/**
+ * @file fft_tables.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the compile-time generation of the FFT twiddle and bit reversal tables, and the bit reversal
+ *        permutation
+ */
+
+#ifndef H_FFT_TABLES_HPP
+#define H_FFT_TABLES_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numbers>
+#include <utility>
+#include "fft_types.hpp"
+#include "instrumentation.hpp"
+
+namespace fftemb::fft_utils
+{
+/**
+ * @brief Taylor series of the sine, accurate to double precision in [-π/2, π/2]
+ *
+ * @param x The angle in radians
+ * @return The sine of the angle
+ */
+constexpr double
+sin_series(double x)
+{
+    const auto x2   = x * x;
+    double     term = x;
+    double     sum  = x;
+    for (int n = 1; n < 14; ++n) {
+        term *= -x2 / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Taylor series of the cosine, accurate to double precision in [-π/2, π/2]
+ *
+ * @param x The angle in radians
+ * @return The cosine of the angle
+ */
+constexpr double
+cos_series(double x)
+{
+    const auto x2   = x * x;
+    double     term = 1;
+    double     sum  = 1;
+    for (int n = 1; n < 14; ++n) {
+        term *= -x2 / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Calculates the root of unity e^(2πik/n) at compile time
+ *
+ * The angle is reduced to the first half quadrant with integer arithmetic, so the series is only evaluated where
+ * it converges fastest.
+ *
+ * @param k The index of the root
+ * @param n The order of the root
+ * @return The pair [cosine, sine]
+ */
+constexpr std::pair<double, double>
+unit_root(std::size_t k, std::size_t n)
+{
+    const auto quadrant  = (4 * k / n) % 4;
+    const auto remainder = (4 * k) % n;
+    double     c         = 0;
+    double     s         = 0;
+    if (2 * remainder <= n) {
+        const auto alpha = remainder * (std::numbers::pi / 2) / n;
+        c                = cos_series(alpha);
+        s                = sin_series(alpha);
+    }
+    else {
+        const auto beta = (n - remainder) * (std::numbers::pi / 2) / n;
+        c               = sin_series(beta);
+        s               = cos_series(beta);
+    }
+    switch (quadrant) {
+    case 1:
+        return {-s, c};
+    case 2:
+        return {-c, -s};
+    case 3:
+        return {s, -c};
+    default:
+        return {c, s};
+    }
+}
+
+/**
+ * @brief Builds the twiddle table e^(2πik/N), for k in [0, N/2)
+ *
+ * @tparam N The transform size
+ * @tparam T The complex number type
+ * @return The twiddle table
+ */
+template <std::size_t N, typename T = Complex>
+constexpr std::array<T, N / 2>
+make_twiddle_rom()
+{
+    std::array<T, N / 2> twiddles{};
+    for (std::size_t k = 0; k < N / 2; ++k) {
+        const auto [c, s] = unit_root(k, N);
+        twiddles[k]       = T(c, s);
+    }
+    return twiddles;
+}
+
+/**
+ * @brief Reverses the lowest bits of an index
+ *
+ * @param index The index
+ * @param levels The number of bits to reverse
+ * @return The reversed index
+ */
+constexpr std::size_t
+reverse_bits(std::size_t index, std::size_t levels)
+{
+    std::size_t reversed = 0;
+    for (std::size_t bit = 0; bit < levels; ++bit) {
+        reversed = (reversed << 1) | ((index >> bit) & 1);
+    }
+    return reversed;
+}
+
+/**
+ * @brief Counts the swaps needed by the bit reversal permutation of size N
+ *
+ * @tparam N The transform size
+ * @return The number of index pairs [i, j] with i < j
+ */
+template <std::size_t N>
+constexpr std::size_t
+bit_reversal_swap_count()
+{
+    const auto  levels = static_cast<std::size_t>(cnl::log2p1(N) - 1);
+    std::size_t count  = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        if (reverse_bits(i, levels) > i) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Builds the list of swaps of the bit reversal permutation of size N
+ *
+ * @tparam N The transform size
+ * @return The index pairs [i, j] with i < j
+ */
+template <std::size_t N>
+constexpr std::array<std::pair<uint32_t, uint32_t>, bit_reversal_swap_count<N>()>
+make_bit_reversal_swaps()
+{
+    const auto levels = static_cast<std::size_t>(cnl::log2p1(N) - 1);
+    std::array<std::pair<uint32_t, uint32_t>, bit_reversal_swap_count<N>()> swaps{};
+    std::size_t                                                             count = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto j = reverse_bits(i, levels);
+        if (j > i) {
+            swaps[count++] = {static_cast<uint32_t>(i), static_cast<uint32_t>(j)};
+        }
+    }
+    return swaps;
+}
+
+/// @brief The twiddle ROM of the transform of size N
+template <std::size_t N, typename T = Complex>
+inline constexpr std::array<T, N / 2> k_twiddle_rom = make_twiddle_rom<N, T>();
+
+/// @brief The bit reversal swap list of the transform of size N
+template <std::size_t N>
+inline constexpr auto k_bit_reversal_swaps = make_bit_reversal_swaps<N>();
+
+/// @brief The number of low (and high) index bits of the tiles of the bit reversal permutation, 16 x 16 elements
+inline constexpr std::size_t k_bit_reversal_tile_bits = 4;
+
+/**
+ * @brief Applies the bit reversal permutation in place, in tiles that fit in the L1 cache
+ *
+ * The index is split into its q high bits a, its middle bits b and its q low bits c, so that the element [a, b, c]
+ * goes to [rev(c), rev(b), rev(a)]. The tiles of the 2^q x 2^q elements sharing b, and of the ones sharing rev(b),
+ * are copied to a buffer and written back transposed (a COBRA permutation): the memory is only accessed in runs of
+ * 2^q consecutive elements, instead of one scattered swap per element. Smaller sizes are swapped with a reversed
+ * counter, whose increment costs O(1) amortized.
+ *
+ * @param[in,out] data The sequence of elements
+ * @param size The number of elements (must be a power of 2)
+ */
+template <typename T>
+void
+permute_bit_reversed(T* data, std::size_t size)
+{
+    if (size < 2) {
+        return;
+    }
+    FFTEMB_PROBE(bit_reversal);
+    using Tile                   = std::array<T, (std::size_t{1} << (2 * k_bit_reversal_tile_bits))>;
+    constexpr std::size_t q      = k_bit_reversal_tile_bits;
+    constexpr std::size_t side   = std::size_t{1} << q;
+    const auto            levels = static_cast<std::size_t>(std::countr_zero(size));
+
+    if (levels < 2 * q) {
+        for (std::size_t i = 1, j = 0; i < size; ++i) {
+            // reversed increment of j
+            std::size_t bit = size >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j |= bit;
+            if (j > i) {
+                std::swap(data[i], data[j]);
+            }
+        }
+        return;
+    }
+
+    const auto                    middle = levels - 2 * q;
+    const auto                    stride = size >> q;
+    std::array<std::size_t, side> reversed{};
+    for (std::size_t i = 0; i < side; ++i) {
+        reversed[i] = reverse_bits(i, q);
+    }
+    Tile       first;
+    Tile       second;
+    const auto load = [&](Tile& tile, std::size_t b) {
+        for (std::size_t a = 0; a < side; ++a) {
+            std::copy_n(data + a * stride + b * side, side, tile.begin() + a * side);
+        }
+    };
+    const auto store = [&](const Tile& tile, std::size_t b) {
+        for (std::size_t a = 0; a < side; ++a) {
+            auto* row = data + a * stride + b * side;
+            for (std::size_t c = 0; c < side; ++c) {
+                row[c] = tile[reversed[c] * side + reversed[a]];
+            }
+        }
+    };
+
+    for (std::size_t b = 0; b < (std::size_t{1} << middle); ++b) {
+        const auto b_reversed = reverse_bits(b, middle);
+        if (b_reversed < b) {
+            continue;
+        }
+        load(first, b);
+        if (b_reversed != b) {
+            load(second, b_reversed);
+            store(second, b);
+        }
+        store(first, b_reversed);
+    }
+}
+
+}  // namespace fftemb::fft_utils
+
+#endif  // H_FFT_TABLES_HPP
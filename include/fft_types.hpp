@@ -7,7 +7,10 @@
 #ifndef H_FFT_TYPES_HPP
 #define H_FFT_TYPES_HPP
 
+#include <cmath>
 #include <complex>
+#include <span>
+#include <type_traits>
 #include "cnl/all.h"
 
 namespace fftemb
@@ -19,6 +22,85 @@ using safe_rounding_elastic_integer
                        -20>;
 /// @brief The complex type
 using Complex = std::complex<safe_rounding_elastic_integer>;
+
+/// @brief Q11.20 without overflow checks nor rounding (see FftKernel for the paths that saturate it instead)
+using fast_elastic_integer = cnl::fixed_point<cnl::elastic_integer<31, int32_t>, -20>;
+/// @brief Q1.14 in a 16-bit word, unchecked; the integer bit keeps the twiddle factor 1 representable
+using q1_14 = cnl::fixed_point<cnl::elastic_integer<15, int16_t>, -14>;
+/// @brief Q1.30 in a 32-bit word, unchecked; the integer bit keeps the twiddle factor 1 representable
+using q1_30 = cnl::fixed_point<cnl::elastic_integer<31, int32_t>, -30>;
+/// @brief The complex type of fast_elastic_integer
+using FastComplex = std::complex<fast_elastic_integer>;
+/// @brief The complex type of q1_14
+using ComplexQ14 = std::complex<q1_14>;
+/// @brief The complex type of q1_30
+using ComplexQ30 = std::complex<q1_30>;
+
+/// @brief A std::span of dynamic extent, to pass spans as the Container of the templates of the library
+template <typename T>
+using Span = std::span<T>;
+
+/**
+ * @brief The operations on the real type of the complex numbers that are not covered by the arithmetic operators
+ *
+ * The primary template serves CNL's fixed-point types; floating-point types have their own specialization. The
+ * calls are resolved at compile time, so every type runs its own operations without any dispatch.
+ *
+ * @tparam Real The real type
+ */
+template <typename Real, typename = void>
+struct numeric_traits
+{
+    /// @brief Whether the type is a fixed-point one
+    static constexpr bool is_fixed_point = true;
+
+    /**
+     * @brief Calculates the square root
+     *
+     * @param value The value, of any fixed-point type
+     * @return The square root
+     */
+    template <typename Value>
+    static auto
+    sqrt(const Value& value)
+    {
+        return cnl::sqrt(value);
+    }
+
+    /**
+     * @brief Calculates the quotient of a division, with the precision of the dividend
+     *
+     * @param dividend The dividend
+     * @param divisor The divisor
+     * @return The quotient
+     */
+    template <typename Dividend, typename Divisor>
+    static auto
+    quotient(const Dividend& dividend, const Divisor& divisor)
+    {
+        return cnl::quotient(dividend, divisor);
+    }
+};
+
+template <typename Real>
+struct numeric_traits<Real, std::enable_if_t<std::is_floating_point_v<Real>>>
+{
+    static constexpr bool is_fixed_point = false;
+
+    template <typename Value>
+    static auto
+    sqrt(const Value& value)
+    {
+        return std::sqrt(value);
+    }
+
+    template <typename Dividend, typename Divisor>
+    static auto
+    quotient(const Dividend& dividend, const Divisor& divisor)
+    {
+        return dividend / divisor;
+    }
+};
 }  // namespace fftemb
 
 #endif  // H_FFT_TYPES_HPP
@@ -0,0 +1,257 @@
+/**
+ * @file fft_zoom.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the ZoomFft class
+ */
+
+#ifndef H_FFT_ZOOM_HPP
+#define H_FFT_ZOOM_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <utility>
+#include <vector>
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+#include "window.hpp"
+
+namespace fftemb
+{
+namespace fft_utils
+{
+/// @brief The number of nonzero coefficients on each side of the half-band filters of the intermediate decimations
+inline constexpr std::size_t k_half_band_side_taps = 4;
+
+/// @brief The number of nonzero coefficients on each side of the half-band filter of the last decimation, which sets
+/// the flat part of the band
+inline constexpr std::size_t k_last_half_band_side_taps = 8;
+
+/// @brief The number of samples between two exact evaluations of the mixer, which rotates by products in between
+inline constexpr std::size_t k_mixer_resync = 64;
+
+/**
+ * @brief Designs a half-band lowpass filter for the decimations by 2, a sinc with a Blackman window
+ *
+ * A half-band filter has a center tap of 1/2 and zeros on the other even offsets, so only the odd offsets are kept.
+ *
+ * @tparam P The number of nonzero coefficients on each side, for 4 P - 1 taps
+ * @return The coefficients of the offsets ±1, ±3, ..., ±(2 P - 1), scaled for a unit gain at DC
+ */
+template <std::size_t P>
+std::array<double, P>
+make_half_band()
+{
+    constexpr auto        half_length = 2.0 * P;
+    std::array<double, P> coefficients;
+    double                sum = 0;
+    for (std::size_t q = 0; q < P; ++q) {
+        const auto offset = 2.0 * q + 1;
+        const auto window = 0.42 + 0.5 * std::cos(std::numbers::pi * offset / half_length)
+                            + 0.08 * std::cos(2 * std::numbers::pi * offset / half_length);
+        coefficients[q] = std::sin(std::numbers::pi * offset / 2) / (std::numbers::pi * offset) * window;
+        sum += coefficients[q];
+    }
+    for (auto& coefficient : coefficients) {
+        coefficient *= 0.25 / sum;
+    }
+    return coefficients;
+}
+
+/**
+ * @brief Lowpass filters a signal with a half-band filter and keeps every other sample
+ *
+ * @param in The signal, readable and zero for 2 P samples before and after it
+ * @param size The number of samples of the signal (must be even)
+ * @param[out] out The size / 2 decimated samples
+ * @param coefficients The coefficients of make_half_band()
+ */
+template <std::size_t P>
+void
+decimate_by_2(const std::complex<double>*  in,
+              std::size_t                  size,
+              std::complex<double>*        out,
+              const std::array<double, P>& coefficients)
+{
+    for (std::size_t m = 0; m < size / 2; ++m) {
+        const auto* center = in + 2 * m;
+        auto        sum    = 0.5 * center[0];
+        for (std::size_t q = 0; q < P; ++q) {
+            const auto offset = static_cast<std::ptrdiff_t>(2 * q + 1);
+            sum += coefficients[q] * (center[-offset] + center[offset]);
+        }
+        out[m] = sum;
+    }
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Zoom FFT: high resolution on a narrow band around a center frequency, with a small transform
+ *
+ * A block of M D samples is mixed down, so that the center frequency lands on 0 Hz, then lowpass filtered and
+ * decimated by D through a cascade of half-band filters, and the remaining M samples are windowed and transformed.
+ * The bins are spaced by 1 / (M D Ts), the resolution of a transform of the whole block, for about 22 M D real
+ * multiplies in double plus an M-point FFT, instead of the 2 M D log2(M D) real multiplies of a transform of the
+ * whole block. Only the last decimation needs a sharp filter: the earlier ones keep a band much narrower than their
+ * own, and reject above 60 dB what folds onto it. The last filter is flat within the central 60 % of the bins; the
+ * outer ones are attenuated and take aliases from beyond the band.
+ *
+ * @tparam M The transform size (must be a power of 2)
+ * @tparam D The decimation factor (must be a power of 2)
+ * @tparam T The complex number type
+ */
+template <std::size_t M, std::size_t D, typename T = Complex>
+class ZoomFft
+{
+    static_assert(cnl::ispow2(D), "The decimation factor must be a power of 2");
+
+public:
+    /**
+     * @brief Construct a new zoom FFT
+     *
+     * @param center_frequency The frequency moved to the bin 0, in Hz
+     * @param sampling_period The sampling period of the signal
+     * @param window The window function of the decimated samples
+     * @param input_scale A factor folded into the window, to keep the spectrum within the range of the type
+     */
+    ZoomFft(double                   center_frequency,
+            std::chrono::nanoseconds sampling_period,
+            WindowType               window      = WindowType::hann,
+            double                   input_scale = 1);
+
+    /**
+     * @brief Computes the zoomed spectrum of a block of samples
+     *
+     * A sinusoid of amplitude A on a bin reads an amplitude 2|X| / M of A, as the spectra of find_peaks().
+     *
+     * @param signal The block, with at least M D samples
+     * @param[out] spectrum The M bins, in the order of the FFT: the bin j is j / (M D Ts) Hz above the center
+     * frequency, and the bins from M / 2 are below it
+     */
+    template <template <class...> class Container>
+    void
+    execute(const Container<T>& signal, Container<T>& spectrum);
+
+    /**
+     * @brief Get the frequency of a bin of the zoomed spectrum
+     *
+     * @param bin The index of the bin, in [0, M)
+     * @return The frequency, in Hz
+     */
+    double
+    frequency(std::size_t bin) const
+    {
+        const auto offset = bin < M / 2 ? static_cast<double>(bin) : static_cast<double>(bin) - M;
+        return m_center_frequency + offset * m_resolution;
+    }
+
+    /**
+     * @brief Get the spacing of the bins
+     *
+     * @return The resolution 1 / (M D Ts), in Hz
+     */
+    double
+    resolution() const
+    {
+        return m_resolution;
+    }
+
+    /**
+     * @brief Get the block size
+     *
+     * @return The number of samples of each block
+     */
+    static constexpr std::size_t
+    size()
+    {
+        return M * D;
+    }
+
+private:
+    /// @brief The zeros around the buffers, read by the half-band filter past the edges of the block
+    static constexpr std::size_t k_padding = 2 * fft_utils::k_last_half_band_side_taps;
+
+    /// @brief The transform of the decimated samples
+    FftPlan<M, T> m_plan;
+    /// @brief The window coefficients, with the coherent gain correction and the input scale
+    std::array<double, M> m_window;
+    /// @brief The coefficients of the half-band filter of the intermediate decimations
+    std::array<double, fft_utils::k_half_band_side_taps> m_half_band;
+    /// @brief The coefficients of the half-band filter of the last decimation
+    std::array<double, fft_utils::k_last_half_band_side_taps> m_last_half_band;
+    /// @brief The mixed block, then every other decimation, between the padding
+    std::vector<std::complex<double>> m_mixed;
+    /// @brief The decimations in between, between the padding
+    std::vector<std::complex<double>> m_decimated;
+    /// @brief The center frequency, in Hz
+    double m_center_frequency;
+    /// @brief The spacing of the bins, in Hz
+    double m_resolution;
+    /// @brief The rotation of the mixer per sample, in radians
+    double m_mixer_step;
+};
+
+template <std::size_t M, std::size_t D, typename T>
+ZoomFft<M, D, T>::ZoomFft(double                   center_frequency,
+                          std::chrono::nanoseconds sampling_period,
+                          WindowType               window,
+                          double                   input_scale)
+  : m_half_band(fft_utils::make_half_band<fft_utils::k_half_band_side_taps>())
+  , m_last_half_band(fft_utils::make_half_band<fft_utils::k_last_half_band_side_taps>())
+  , m_mixed(M * D + 2 * k_padding)
+  , m_decimated(M * D / 2 + 2 * k_padding)
+  , m_center_frequency(center_frequency)
+{
+    const auto period = std::chrono::duration_cast<std::chrono::duration<double>>(sampling_period).count();
+    m_resolution      = 1 / (M * D * period);
+    // the transforms take e^(2πikn/N), so the band is moved down by e^(2πi fc n Ts)
+    m_mixer_step = 2 * std::numbers::pi * center_frequency * period;
+
+    const auto& table = window_table<double>(window, M);
+    for (std::size_t i = 0; i < M; ++i) {
+        m_window[i] = table[i] * input_scale;
+    }
+}
+
+template <std::size_t M, std::size_t D, typename T>
+template <template <class...> class Container>
+void
+ZoomFft<M, D, T>::execute(const Container<T>& signal, Container<T>& spectrum)
+{
+    auto*      samples = m_mixed.data() + k_padding;
+    auto*      other   = m_decimated.data() + k_padding;
+    const auto step    = std::polar(1.0, m_mixer_step);
+    auto       mixer   = std::complex<double>(1);
+    for (std::size_t n = 0; n < M * D; ++n) {
+        if (n % fft_utils::k_mixer_resync == 0) {
+            mixer = std::polar(1.0, m_mixer_step * n);
+        }
+        samples[n] = std::complex<double>(static_cast<double>(signal[n].real()), static_cast<double>(signal[n].imag()))
+                     * mixer;
+        mixer *= step;
+    }
+
+    for (std::size_t size = M * D; size > M; size /= 2) {
+        if (size == 2 * M) {
+            fft_utils::decimate_by_2(samples, size, other, m_last_half_band);
+        }
+        else {
+            fft_utils::decimate_by_2(samples, size, other, m_half_band);
+        }
+        std::fill_n(other + size / 2, k_padding, std::complex<double>(0));
+        std::swap(samples, other);
+    }
+
+    for (std::size_t i = 0; i < M; ++i) {
+        spectrum[i] = T(samples[i].real() * m_window[i], samples[i].imag() * m_window[i]);
+    }
+    m_plan.execute(spectrum);
+}
+
+}  // namespace fftemb
+
+#endif  // H_FFT_ZOOM_HPP
@@ -0,0 +1,147 @@
+/**
+ * @file ingest.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the ingest of raw integer samples, such as ADC readings, into complex signals
+ */
+
+#ifndef H_INGEST_HPP
+#define H_INGEST_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include "etl/vector.h"
+#include "fft_simd.hpp"
+#include "fft_types.hpp"
+#include "window.hpp"
+
+namespace fftemb::fft_utils
+{
+/// @brief The shift that maps the full scale of an integer sample type to 1, e.g. 15 for int16_t
+template <typename Sample>
+inline constexpr int k_full_scale_shift = std::numeric_limits<Sample>::digits;
+
+/**
+ * @brief Converts integer samples into a signal, each sample x becoming (x - mean) 2^-shift w(i), in a single pass
+ *
+ * For Complex and FastComplex, the samples are shifted straight into the raw Q11.20 integers, rounding half away
+ * from zero and saturating, and multiplied by the raw window coefficients: the whole pass is integer arithmetic, with
+ * no conversion through double, no separate window pass and no normalization pass. The other types are converted
+ * through double in the same pass. The mean, when removed, takes a read-only pass over the samples beforehand.
+ *
+ * @param samples The samples, of which every stride-th one is read, from the first
+ * @param[out] signal The signal, of as many elements as the samples read
+ * @param window The coefficients of the window (with the coherent gain correction), null for none
+ * @param shift The number of fractional bits of the samples
+ * @param remove_dc Whether the mean of the samples read is subtracted
+ * @param stride The distance between the samples read, e.g. the number of channels of interleaved samples
+ */
+template <typename Sample, typename T, template <class...> class Container>
+void
+ingest_samples(std::span<const Sample>       samples,
+               Container<T>&                 signal,
+               const typename T::value_type* window,
+               int                           shift,
+               bool                          remove_dc,
+               std::size_t                   stride = 1)
+{
+    static_assert(std::is_integral_v<Sample> && std::is_signed_v<Sample>, "The samples must be signed integers");
+    const auto size = (samples.size() + stride - 1) / stride;
+    double     mean = 0;
+    if (remove_dc && size > 0) {
+        int64_t sum = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            sum += samples[i * stride];
+        }
+        mean = static_cast<double>(sum) / size;
+    }
+
+    if constexpr (simd::k_is_q20_layout<T>) {
+        static_assert(sizeof(typename T::value_type) == sizeof(int32_t), "The window must hold raw Q11.20 integers");
+        const int     left       = std::max(0, simd::k_fraction_bits - shift);
+        const int     right      = std::max(0, shift - simd::k_fraction_bits);
+        const int64_t half       = right > 0 ? int64_t{1} << (right - 1) : 0;
+        const int64_t negative   = right > 0 ? 1 : 0;
+        const auto    dc         = static_cast<int64_t>(std::llround(std::ldexp(mean, simd::k_fraction_bits - shift)));
+        const auto*   raw_window = reinterpret_cast<const int32_t*>(window);
+        auto*         raw        = reinterpret_cast<int32_t*>(signal.data());
+        for (std::size_t i = 0; i < size; ++i) {
+            // as in narrow_product, taking 1 off the bias of the negative values rounds them half away from zero
+            const auto scaled = int64_t{samples[i * stride]} * (int64_t{1} << left);
+            const auto value  = ((scaled + half - negative * (scaled < 0)) >> right) - dc;
+            // saturated first, so that the product with the window fits in 64 bits whatever the shift
+            raw[2 * i]     = window ? simd::narrow_product(int64_t{simd::saturate(value)} * raw_window[i])
+                                    : simd::saturate(value);
+            raw[2 * i + 1] = 0;
+        }
+    }
+    else {
+        using Real       = typename T::value_type;
+        const auto scale = std::ldexp(1.0, -shift);
+        for (std::size_t i = 0; i < size; ++i) {
+            auto value = (samples[i * stride] - mean) * scale;
+            if (window) {
+                value *= static_cast<double>(window[i]);
+            }
+            signal[i] = T(static_cast<Real>(value), 0);
+        }
+    }
+}
+
+/**
+ * @brief Converts integer samples into a signal, each sample x becoming (x - mean) 2^-shift
+ *
+ * @param samples The samples, such as an ADC or a DMA buffer
+ * @param[out] signal The signal, of as many elements as the samples
+ * @param shift The number of fractional bits of the samples, their full scale mapping to 1 by default
+ * @param remove_dc Whether the mean of the samples is subtracted
+ */
+template <typename Sample,
+          std::size_t Extent,
+          typename T                          = Complex,
+          template <class...> class Container = etl::ivector>
+void
+ingest(std::span<Sample, Extent> samples,
+       Container<T>&             signal,
+       int                       shift     = k_full_scale_shift<std::remove_const_t<Sample>>,
+       bool                      remove_dc = false)
+{
+    using Value = std::remove_const_t<Sample>;
+    ingest_samples<Value, T, Container>(std::span<const Value>(samples), signal, nullptr, shift, remove_dc);
+}
+
+/**
+ * @brief Converts integer samples into a signal multiplied by a window, each sample x becoming
+ * (x - mean) 2^-shift w(i)
+ *
+ * The cached table of the window is used, as in apply_window().
+ *
+ * @param samples The samples, such as an ADC or a DMA buffer
+ * @param[out] signal The signal, of as many elements as the samples
+ * @param type The window function
+ * @param shift The number of fractional bits of the samples, their full scale mapping to 1 by default
+ * @param remove_dc Whether the mean of the samples is subtracted
+ */
+template <typename Sample,
+          std::size_t Extent,
+          typename T                          = Complex,
+          template <class...> class Container = etl::ivector>
+void
+ingest(std::span<Sample, Extent> samples,
+       Container<T>&             signal,
+       WindowType                type,
+       int                       shift     = k_full_scale_shift<std::remove_const_t<Sample>>,
+       bool                      remove_dc = false)
+{
+    using Value        = std::remove_const_t<Sample>;
+    const auto& window = window_table<typename T::value_type>(type, samples.size());
+    ingest_samples<Value, T, Container>(std::span<const Value>(samples), signal, window.data(), shift, remove_dc);
+}
+
+}  // namespace fftemb::fft_utils
+
+#endif  // H_INGEST_HPP
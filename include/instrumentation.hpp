@@ -0,0 +1,450 @@
+/**
+ * @file instrumentation.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the opt-in instrumentation of the hot paths: timings, saturation counters and headroom per stage
+ */
+
+#ifndef H_INSTRUMENTATION_HPP
+#define H_INSTRUMENTATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+/// @brief Whether the hot paths record their timings and counters, off unless defined to 1 (CMake: INSTRUMENTATION)
+#ifndef FFTEMB_INSTRUMENTATION
+#define FFTEMB_INSTRUMENTATION 0
+#endif
+
+namespace fftemb::instrumentation
+{
+/// @brief Whether the instrumentation is compiled in
+inline constexpr bool k_enabled = FFTEMB_INSTRUMENTATION != 0;
+
+/// @brief The number of butterfly stages recorded, enough for 2^32 points
+inline constexpr std::size_t k_max_stages = 32;
+
+/// @brief The instrumented calls
+enum class Probe
+{
+    /// @brief A whole compute() call
+    compute,
+    /// @brief A bit reversal permutation
+    bit_reversal,
+    /// @brief A window multiplication
+    window,
+    /// @brief A normalization
+    normalize
+};
+
+/// @brief The number of probes
+inline constexpr std::size_t k_probe_count = 4;
+
+/// @brief The names of the probes, as they appear in the dumps
+inline constexpr std::array<const char*, k_probe_count> k_probe_names{"compute", "bit_reversal", "window", "normalize"};
+
+/// @brief The timings of the calls of a probe or a stage
+struct Timing
+{
+    /// @brief The number of calls
+    uint64_t calls = 0;
+    /// @brief The total time of the calls, in ns
+    uint64_t nanoseconds = 0;
+    /// @brief The total time of the calls, in CPU cycles (0 where no cycle counter is available)
+    uint64_t cycles = 0;
+    /// @brief The longest call, in ns
+    uint64_t max_nanoseconds = 0;
+};
+
+/// @brief The counters of a butterfly stage
+struct StageStatistics
+{
+    /// @brief The timings of the stage
+    Timing timing;
+    /// @brief The number of components at the rails of the type after the stage, saturated (or about to overflow)
+    uint64_t saturations = 0;
+    /// @brief The largest component after the stage, as a fraction of the range of the type
+    double peak = 0;
+
+    /**
+     * @brief Get the smallest headroom seen after the stage
+     *
+     * @return The number of bits by which the largest component could still grow, infinite if it was never recorded
+     */
+    double
+    headroom_bits() const
+    {
+        return peak > 0 ? -std::log2(peak) : std::numeric_limits<double>::infinity();
+    }
+};
+
+/// @brief A copy of all the counters
+struct Snapshot
+{
+    /// @brief The timings of each probe, indexed by Probe
+    std::array<Timing, k_probe_count> probes;
+    /// @brief The counters of each butterfly stage, the first one (of length 2) at index 0
+    std::array<StageStatistics, k_max_stages> stages;
+};
+
+namespace detail
+{
+/// @brief The shared timings of a probe or a stage
+struct AtomicTiming
+{
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> nanoseconds{0};
+    std::atomic<uint64_t> cycles{0};
+    std::atomic<uint64_t> max_nanoseconds{0};
+
+    void
+    add(uint64_t elapsed_nanoseconds, uint64_t elapsed_cycles)
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        nanoseconds.fetch_add(elapsed_nanoseconds, std::memory_order_relaxed);
+        cycles.fetch_add(elapsed_cycles, std::memory_order_relaxed);
+        auto longest = max_nanoseconds.load(std::memory_order_relaxed);
+        while (elapsed_nanoseconds > longest
+               && !max_nanoseconds.compare_exchange_weak(longest, elapsed_nanoseconds, std::memory_order_relaxed)) {
+        }
+    }
+
+    Timing
+    load() const
+    {
+        return {calls.load(std::memory_order_relaxed),
+                nanoseconds.load(std::memory_order_relaxed),
+                cycles.load(std::memory_order_relaxed),
+                max_nanoseconds.load(std::memory_order_relaxed)};
+    }
+
+    void
+    reset()
+    {
+        calls           = 0;
+        nanoseconds     = 0;
+        cycles          = 0;
+        max_nanoseconds = 0;
+    }
+};
+
+/// @brief The shared counters of a butterfly stage
+struct AtomicStage
+{
+    AtomicTiming          timing;
+    std::atomic<uint64_t> saturations{0};
+    std::atomic<double>   peak{0};
+};
+
+/// @brief The counters of the process, updated with relaxed atomics from any thread
+struct Registry
+{
+    std::array<AtomicTiming, k_probe_count> probes;
+    std::array<AtomicStage, k_max_stages>   stages;
+};
+
+/**
+ * @brief Get the counters of the process
+ *
+ * @return The registry
+ */
+inline Registry&
+registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+/**
+ * @brief Reads the cycle counter of the CPU
+ *
+ * @return The number of cycles since an arbitrary origin, or 0 where no counter is available
+ */
+inline uint64_t
+cycle_count()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+}  // namespace detail
+
+/// @brief A point in time, in ns and in cycles
+struct Timestamp
+{
+    std::chrono::steady_clock::time_point time;
+    uint64_t                              cycles;
+};
+
+/**
+ * @brief Get the current time
+ *
+ * @return The timestamp
+ */
+inline Timestamp
+now()
+{
+    return {std::chrono::steady_clock::now(), detail::cycle_count()};
+}
+
+/**
+ * @brief Get the time elapsed since a timestamp
+ *
+ * @param start The timestamp
+ * @return The elapsed [ns, cycles]
+ */
+inline std::pair<uint64_t, uint64_t>
+elapsed(const Timestamp& start)
+{
+    const auto end = now();
+    return {static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end.time - start.time).count()),
+            end.cycles - start.cycles};
+}
+
+/**
+ * @brief Times a probe from its construction to its destruction
+ */
+class ScopedProbe
+{
+public:
+    /**
+     * @brief Starts timing a probe
+     *
+     * @param probe The probe
+     */
+    explicit ScopedProbe(Probe probe) : m_probe(probe), m_start(now()) {}
+
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe&
+    operator=(const ScopedProbe&) = delete;
+
+    /**
+     * @brief Records the time of the probe
+     */
+    ~ScopedProbe()
+    {
+        const auto [nanoseconds, cycles] = elapsed(m_start);
+        detail::registry().probes[static_cast<std::size_t>(m_probe)].add(nanoseconds, cycles);
+    }
+
+private:
+    /// @brief The timed probe
+    Probe m_probe;
+    /// @brief The start of the call
+    Timestamp m_start;
+};
+
+/**
+ * @brief Records a butterfly stage: its time, and the saturations and the peak of its output
+ *
+ * The output is scanned once, so the cost is O(N) on top of the stage, only paid by instrumented builds. The
+ * components are either the elements themselves, for the raw integers of the SIMD engine, or their real and
+ * imaginary parts, compared to the largest value of their type.
+ *
+ * @param stage The index of the stage, 0 for the butterflies of length 2
+ * @param start The start of the stage
+ * @param data The output of the stage
+ * @param size The number of elements
+ */
+template <typename E>
+void
+record_stage(std::size_t stage, const Timestamp& start, const E* data, std::size_t size)
+{
+    const auto [nanoseconds, cycles] = elapsed(start);
+    if (stage >= k_max_stages) {
+        return;
+    }
+
+    double   peak        = 0;
+    uint64_t saturations = 0;
+    double   range       = 0;
+    const auto visit     = [&](double component) {
+        const auto magnitude = std::abs(component);
+        peak                 = std::max(peak, magnitude);
+        saturations += magnitude >= range;
+    };
+    if constexpr (std::is_arithmetic_v<E>) {
+        range = static_cast<double>(std::numeric_limits<E>::max());
+        for (std::size_t i = 0; i < size; ++i) {
+            visit(static_cast<double>(data[i]));
+        }
+    }
+    else {
+        range = static_cast<double>(std::numeric_limits<typename E::value_type>::max());
+        for (std::size_t i = 0; i < size; ++i) {
+            visit(static_cast<double>(data[i].real()));
+            visit(static_cast<double>(data[i].imag()));
+        }
+    }
+
+    auto& counters = detail::registry().stages[stage];
+    counters.timing.add(nanoseconds, cycles);
+    counters.saturations.fetch_add(saturations, std::memory_order_relaxed);
+    const auto fraction = peak / range;
+    auto       largest  = counters.peak.load(std::memory_order_relaxed);
+    while (fraction > largest && !counters.peak.compare_exchange_weak(largest, fraction, std::memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Copies all the counters
+ *
+ * @return The snapshot, all zeros unless the instrumentation is compiled in
+ */
+inline Snapshot
+snapshot()
+{
+    Snapshot    result;
+    const auto& counters = detail::registry();
+    for (std::size_t i = 0; i < k_probe_count; ++i) {
+        result.probes[i] = counters.probes[i].load();
+    }
+    for (std::size_t i = 0; i < k_max_stages; ++i) {
+        result.stages[i].timing      = counters.stages[i].timing.load();
+        result.stages[i].saturations = counters.stages[i].saturations.load(std::memory_order_relaxed);
+        result.stages[i].peak        = counters.stages[i].peak.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+/**
+ * @brief Clears all the counters
+ */
+inline void
+reset()
+{
+    auto& counters = detail::registry();
+    for (auto& probe : counters.probes) {
+        probe.reset();
+    }
+    for (auto& stage : counters.stages) {
+        stage.timing.reset();
+        stage.saturations = 0;
+        stage.peak        = 0;
+    }
+}
+
+/**
+ * @brief Formats a snapshot in the Prometheus text exposition format
+ *
+ * Each metric family is a single block, its TYPE line followed by all its samples. Only the stages that were recorded
+ * are listed, labelled by their index, and the headroom of a stage whose output was all zeros is omitted.
+ *
+ * @param counters The snapshot
+ * @return The metrics
+ */
+inline std::string
+to_prometheus(const Snapshot& counters)
+{
+    std::ostringstream out;
+    const auto         timing = [&out, &counters](const char* name, const char* type, auto value) {
+        out << "# TYPE " << name << ' ' << type << '\n';
+        for (std::size_t i = 0; i < k_probe_count; ++i) {
+            out << name << "{probe=\"" << k_probe_names[i] << "\"} " << value(counters.probes[i]) << '\n';
+        }
+        for (std::size_t i = 0; i < k_max_stages; ++i) {
+            if (counters.stages[i].timing.calls != 0) {
+                out << name << "{probe=\"stage\",stage=\"" << i << "\"} " << value(counters.stages[i].timing) << '\n';
+            }
+        }
+    };
+    timing("fftemb_calls_total", "counter", [](const Timing& value) { return value.calls; });
+    timing("fftemb_nanoseconds_total", "counter", [](const Timing& value) { return value.nanoseconds; });
+    timing("fftemb_cycles_total", "counter", [](const Timing& value) { return value.cycles; });
+    timing("fftemb_max_nanoseconds", "gauge", [](const Timing& value) { return value.max_nanoseconds; });
+
+    out << "# TYPE fftemb_stage_saturations_total counter\n";
+    for (std::size_t i = 0; i < k_max_stages; ++i) {
+        const auto& stage = counters.stages[i];
+        if (stage.timing.calls != 0) {
+            out << "fftemb_stage_saturations_total{stage=\"" << i << "\"} " << stage.saturations << '\n';
+        }
+    }
+    out << "# TYPE fftemb_stage_headroom_bits gauge\n";
+    for (std::size_t i = 0; i < k_max_stages; ++i) {
+        const auto& stage = counters.stages[i];
+        if (stage.timing.calls != 0 && stage.peak > 0) {
+            out << "fftemb_stage_headroom_bits{stage=\"" << i << "\"} " << stage.headroom_bits() << '\n';
+        }
+    }
+    return out.str();
+}
+
+/**
+ * @brief Formats a snapshot as JSON
+ *
+ * Only the stages that were recorded are listed. A headroom of a stage whose output was all zeros is null.
+ *
+ * @param counters The snapshot
+ * @return The JSON object
+ */
+inline std::string
+to_json(const Snapshot& counters)
+{
+    std::ostringstream out;
+    const auto         timing = [&out](const Timing& value) {
+        out << "\"calls\":" << value.calls << ",\"nanoseconds\":" << value.nanoseconds << ",\"cycles\":" << value.cycles
+            << ",\"max_nanoseconds\":" << value.max_nanoseconds;
+    };
+    out << "{\"probes\":{";
+    for (std::size_t i = 0; i < k_probe_count; ++i) {
+        out << (i ? "," : "") << '"' << k_probe_names[i] << "\":{";
+        timing(counters.probes[i]);
+        out << '}';
+    }
+    out << "},\"stages\":[";
+    bool first = true;
+    for (std::size_t i = 0; i < k_max_stages; ++i) {
+        const auto& stage = counters.stages[i];
+        if (stage.timing.calls == 0) {
+            continue;
+        }
+        out << (first ? "" : ",") << "{\"stage\":" << i << ',';
+        timing(stage.timing);
+        out << ",\"saturations\":" << stage.saturations << ",\"headroom_bits\":";
+        if (stage.peak > 0) {
+            out << stage.headroom_bits();
+        }
+        else {
+            out << "null";
+        }
+        out << '}';
+        first = false;
+    }
+    out << "]}";
+    return out.str();
+}
+}  // namespace fftemb::instrumentation
+
+#if FFTEMB_INSTRUMENTATION
+#define FFTEMB_INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define FFTEMB_INSTRUMENTATION_CONCAT(a, b) FFTEMB_INSTRUMENTATION_CONCAT_IMPL(a, b)
+/// @brief Times the enclosing scope as a probe of fftemb::instrumentation::Probe
+#define FFTEMB_PROBE(probe)                                                                                        \
+    const ::fftemb::instrumentation::ScopedProbe FFTEMB_INSTRUMENTATION_CONCAT(fftemb_probe_, __LINE__)(          \
+        ::fftemb::instrumentation::Probe::probe)
+/// @brief Starts timing a butterfly stage, in a variable of the given name
+#define FFTEMB_STAGE_BEGIN(name) const auto name = ::fftemb::instrumentation::now()
+/// @brief Records a butterfly stage started by FFTEMB_STAGE_BEGIN, scanning its output
+#define FFTEMB_STAGE_END(name, stage, data, size) ::fftemb::instrumentation::record_stage(stage, name, data, size)
+#else
+#define FFTEMB_PROBE(probe) static_cast<void>(0)
+#define FFTEMB_STAGE_BEGIN(name) static_cast<void>(0)
+#define FFTEMB_STAGE_END(name, stage, data, size) static_cast<void>(0)
+#endif
+
+#endif  // H_INSTRUMENTATION_HPP
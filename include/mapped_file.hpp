@@ -0,0 +1,160 @@
+/**
+ * @file mapped_file.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the MappedFile class
+ */
+
+#ifndef H_MAPPED_FILE_HPP
+#define H_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fftemb
+{
+/**
+ * @brief A file mapped in memory (POSIX), either read-only or created with a given size and written through the
+ * mapping
+ *
+ * Failures are reported by is_open(), never thrown. An empty file is open, with no data.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Maps an existing file, read-only, for a sequential read
+     *
+     * @param path The path of the file
+     */
+    explicit MappedFile(const char* path);
+
+    /**
+     * @brief Creates (or truncates) a file of the given size and maps it for writing
+     *
+     * @param path The path of the file
+     * @param size The size of the file, in bytes
+     */
+    MappedFile(const char* path, std::size_t size);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile&
+    operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+      : m_descriptor(std::exchange(other.m_descriptor, -1)),
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0))
+    {
+    }
+
+    /**
+     * @brief Check whether the file was opened and mapped
+     *
+     * @return Whether the mapping is usable
+     */
+    bool
+    is_open() const
+    {
+        return m_descriptor >= 0;
+    }
+
+    /**
+     * @brief Get the mapped bytes
+     *
+     * @return The contents of the file, empty if it is not open
+     */
+    std::span<std::byte>
+    bytes() const
+    {
+        return {static_cast<std::byte*>(m_data), m_size};
+    }
+
+    /**
+     * @brief Get the size of the file
+     *
+     * @return The number of mapped bytes
+     */
+    std::size_t
+    size() const
+    {
+        return m_size;
+    }
+
+private:
+    /**
+     * @brief Maps the open descriptor, closing it on failure
+     *
+     * @param protection The protection of the mapping
+     */
+    void
+    map(int protection);
+
+    /// @brief The file descriptor, -1 if the file is not open
+    int m_descriptor = -1;
+    /// @brief The mapping, null for an empty file
+    void* m_data = nullptr;
+    /// @brief The size of the mapping
+    std::size_t m_size = 0;
+};
+
+inline MappedFile::MappedFile(const char* path) : m_descriptor(::open(path, O_RDONLY | O_CLOEXEC))
+{
+    struct stat status;
+    if (m_descriptor >= 0 && ::fstat(m_descriptor, &status) == 0) {
+        m_size = static_cast<std::size_t>(status.st_size);
+        map(PROT_READ);
+        if (m_data != nullptr) {
+            ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+        }
+    }
+    else if (m_descriptor >= 0) {
+        ::close(std::exchange(m_descriptor, -1));
+    }
+}
+
+inline MappedFile::MappedFile(const char* path, std::size_t size)
+  : m_descriptor(::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)), m_size(size)
+{
+    if (m_descriptor >= 0 && ::ftruncate(m_descriptor, static_cast<off_t>(size)) == 0) {
+        map(PROT_READ | PROT_WRITE);
+    }
+    else if (m_descriptor >= 0) {
+        ::close(std::exchange(m_descriptor, -1));
+    }
+}
+
+inline MappedFile::~MappedFile()
+{
+    if (m_data != nullptr) {
+        ::munmap(m_data, m_size);
+    }
+    if (m_descriptor >= 0) {
+        ::close(m_descriptor);
+    }
+}
+
+inline void
+MappedFile::map(int protection)
+{
+    if (m_size == 0) {
+        return;
+    }
+    auto* data = ::mmap(nullptr, m_size, protection, MAP_SHARED, m_descriptor, 0);
+    if (data == MAP_FAILED) {
+        ::close(std::exchange(m_descriptor, -1));
+        m_size = 0;
+        return;
+    }
+    m_data = data;
+}
+
+}  // namespace fftemb
+
+#endif  // H_MAPPED_FILE_HPP
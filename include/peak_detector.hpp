@@ -0,0 +1,181 @@
+/**
+ * @file peak_detector.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the spectral peak detector, with top-K selection and sub-bin interpolation
+ */
+
+#ifndef H_PEAK_DETECTOR_HPP
+#define H_PEAK_DETECTOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include "dsp_utils.hpp"
+#include "etl/vector.h"
+#include "fft_types.hpp"
+
+namespace fftemb
+{
+/// @brief The sub-bin interpolations of the peaks
+enum class PeakInterpolation
+{
+    /// @brief The center of the bin, with its magnitude
+    none,
+    /// @brief A parabola through the log power of the peak and of its neighbors, for windowed spectra
+    parabolic,
+    /// @brief Jacobsen's estimator on the complex bins, for spectra of unwindowed signals
+    jacobsen
+};
+
+/// @brief A spectral peak
+struct Peak
+{
+    /// @brief The frequency, in Hz
+    double frequency;
+    /// @brief The amplitude of the sinusoid, 2|X| / N
+    double amplitude;
+    /// @brief The fractional bin index
+    double bin;
+};
+
+namespace fft_utils
+{
+/**
+ * @brief Interpolates a peak between the bins around a local maximum
+ *
+ * @param spectrum The spectrum
+ * @param bin The index of the local maximum, with a neighbor on each side
+ * @param interpolation The interpolation
+ * @return The fractional offset from the bin, within [-0.5, 0.5], and the magnitude at it
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+std::pair<double, double>
+interpolate_peak(const Container<T>& spectrum, std::size_t bin, PeakInterpolation interpolation)
+{
+    const auto to_complex = [](const T& value) {
+        return std::complex<double>(static_cast<double>(value.real()), static_cast<double>(value.imag()));
+    };
+    const auto previous  = to_complex(spectrum[bin - 1]);
+    const auto center    = to_complex(spectrum[bin]);
+    const auto next      = to_complex(spectrum[bin + 1]);
+    const auto magnitude = std::abs(center);
+
+    switch (interpolation) {
+    case PeakInterpolation::parabolic: {
+        // log power: the main lobes of the usual windows are close to gaussians, which are parabolas in log scale
+        const auto alpha       = std::log(std::norm(previous));
+        const auto beta        = std::log(std::norm(center));
+        const auto gamma       = std::log(std::norm(next));
+        const auto denominator = alpha - 2 * beta + gamma;
+        if (!std::isfinite(denominator) || denominator >= 0) {
+            return {0, magnitude};
+        }
+        const auto offset = std::clamp(0.5 * (alpha - gamma) / denominator, -0.5, 0.5);
+        return {offset, std::exp(0.5 * (beta - 0.25 * (alpha - gamma) * offset))};
+    }
+    case PeakInterpolation::jacobsen: {
+        const auto denominator = 2.0 * center - previous - next;
+        if (std::norm(denominator) == 0) {
+            return {0, magnitude};
+        }
+        const auto offset = std::clamp(((previous - next) / denominator).real(), -0.5, 0.5);
+        // the magnitude of the Dirichlet kernel falls as sin(πd) / (πd) away from the tone
+        const auto scallop = offset == 0 ? 1.0 : std::numbers::pi * offset / std::sin(std::numbers::pi * offset);
+        return {offset, magnitude * scallop};
+    }
+    default:
+        return {0, magnitude};
+    }
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Finds the largest peaks of the positive half of a spectrum
+ *
+ * A single pass compares the squared magnitudes of each bin with its neighbors, keeping the local maxima in a
+ * bounded min-heap of MaxPeaks entries, so the cost is O(N log K) and no square root is taken along the way. Only the
+ * selected peaks are interpolated, which gives sub-bin frequencies and amplitudes: a smaller transform then reaches
+ * the frequency accuracy of a larger one.
+ *
+ * @tparam MaxPeaks The maximum number of peaks
+ * @param spectrum The spectrum of N bins
+ * @param sampling_period The sampling period of the signal
+ * @param interpolation The sub-bin interpolation
+ * @return The peaks, the largest one first
+ */
+template <std::size_t MaxPeaks, typename T = Complex, template <class...> class Container = etl::ivector>
+etl::vector<Peak, MaxPeaks>
+find_peaks(const Container<T>&      spectrum,
+           std::chrono::nanoseconds sampling_period,
+           PeakInterpolation        interpolation = PeakInterpolation::parabolic)
+{
+    using Power = decltype(fft_utils::squared_magnitude(spectrum[0]));
+    struct Candidate
+    {
+        Power       power;
+        std::size_t bin;
+    };
+    const auto smaller = [](const Candidate& a, const Candidate& b) { return a.power > b.power; };
+
+    etl::vector<Candidate, MaxPeaks> heap;
+    const std::size_t                half = spectrum.size() / 2;
+    if (half >= 2) {
+        auto previous = fft_utils::squared_magnitude(spectrum[0]);
+        auto current  = fft_utils::squared_magnitude(spectrum[1]);
+        for (std::size_t i = 1; i < half; ++i) {
+            const auto next = fft_utils::squared_magnitude(spectrum[i + 1]);
+            if (current > previous && current >= next) {
+                if (heap.size() < MaxPeaks) {
+                    heap.push_back({current, i});
+                    std::push_heap(heap.begin(), heap.end(), smaller);
+                }
+                else if (current > heap.front().power) {
+                    std::pop_heap(heap.begin(), heap.end(), smaller);
+                    heap.back() = {current, i};
+                    std::push_heap(heap.begin(), heap.end(), smaller);
+                }
+            }
+            previous = current;
+            current  = next;
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), smaller);
+
+    const auto resolution
+        = 1 / (spectrum.size() * std::chrono::duration_cast<std::chrono::duration<double>>(sampling_period).count());
+    etl::vector<Peak, MaxPeaks> peaks;
+    for (const auto& candidate : heap) {
+        const auto [offset, magnitude]
+            = fft_utils::interpolate_peak<T, Container>(spectrum, candidate.bin, interpolation);
+        const auto bin = candidate.bin + offset;
+        peaks.push_back({bin * resolution, 2 * magnitude / spectrum.size(), bin});
+    }
+    return peaks;
+}
+
+/**
+ * @brief Finds the largest peaks of the positive half of a spectrum held in memory owned by the caller
+ *
+ * @tparam MaxPeaks The maximum number of peaks
+ * @param spectrum The spectrum of N bins
+ * @param sampling_period The sampling period of the signal
+ * @param interpolation The sub-bin interpolation
+ * @return The peaks, the largest one first
+ */
+template <std::size_t MaxPeaks, typename T, std::size_t Extent>
+etl::vector<Peak, MaxPeaks>
+find_peaks(std::span<T, Extent>     spectrum,
+           std::chrono::nanoseconds sampling_period,
+           PeakInterpolation        interpolation = PeakInterpolation::parabolic)
+{
+    const Span<T> view(spectrum);
+    return find_peaks<MaxPeaks, T, Span>(view, sampling_period, interpolation);
+}
+
+}  // namespace fftemb
+
+#endif  // H_PEAK_DETECTOR_HPP
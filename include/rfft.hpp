@@ -0,0 +1,107 @@
+/**
+ * @file rfft.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the real-input FFT and its inverse
+ */
+
+#ifndef H_RFFT_HPP
+#define H_RFFT_HPP
+
+#include <complex>
+#include <numbers>
+#include "etl/vector.h"
+#include "fft.hpp"
+#include "fft_types.hpp"
+
+namespace fftemb
+{
+/**
+ * @brief Computes the FFT of a real signal through a complex FFT of half its size
+ *
+ * The even and odd samples are packed as the real and imaginary parts of N/2 complex samples, transformed, and
+ * then split into the spectra of the even and odd samples to build the N/2+1 non-redundant bins. The remaining
+ * bins are the complex conjugates of those, X[N-k] = conj(X[k]).
+ *
+ * @param samples The N real samples (N must be a power of 2, greater than 1)
+ * @param[out] spectrum The N/2+1 bins of the spectrum, from 0 up to the Nyquist frequency
+ * @param kernel The butterfly kernel of the half-size complex FFT
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+rfft(const Container<typename T::value_type>& samples, Container<T>& spectrum, FftKernel kernel = FftKernel::split_radix)
+{
+    const std::size_t half_size = samples.size() / 2;
+    const auto        half      = typename T::value_type{0.5};
+
+    spectrum.resize(half_size);
+    for (std::size_t i = 0; i < half_size; ++i) {
+        spectrum[i] = T(samples[2 * i], samples[2 * i + 1]);
+    }
+
+    compute(spectrum, kernel);
+
+    spectrum.resize(half_size + 1);
+    const auto z0          = spectrum[0];
+    spectrum[0]            = T(z0.real() + z0.imag(), 0);
+    spectrum[half_size]    = T(z0.real() - z0.imag(), 0);
+    const auto           step = std::polar(1.0, std::numbers::pi / half_size);
+    std::complex<double> w    = step;
+    for (std::size_t k = 1; k <= half_size / 2; ++k, w *= step) {
+        const T    twiddle(w.real(), w.imag());
+        const auto z_k      = spectrum[k];
+        const auto z_mirror = std::conj(spectrum[half_size - k]);
+        const auto even     = z_k + z_mirror;
+        const auto odd_diff = z_k - z_mirror;
+        const auto odd      = twiddle * T(odd_diff.imag(), -odd_diff.real());
+
+        spectrum[k]             = (even + odd) * half;
+        spectrum[half_size - k] = std::conj(even - odd) * half;
+    }
+}
+
+/**
+ * @brief Computes the inverse of rfft, through an inverse complex FFT of half the signal size
+ *
+ * The packed spectrum is rebuilt at half scale and goes through the inverse radix-2 stages of compute_inverse(),
+ * which halve every stage, so the samples never grow past twice the bins on the way, and are doubled at the end.
+ *
+ * @param[in,out] spectrum The N/2+1 bins of the spectrum, used as the work buffer (its content is lost)
+ * @param[out] samples The N real samples, which must already have N elements
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+irfft(Container<T>& spectrum, Container<typename T::value_type>& samples)
+{
+    const std::size_t half_size = spectrum.size() - 1;
+    const auto        half      = typename T::value_type{0.5};
+
+    // rebuild half of the packed spectrum Z[k] = E[k] + i O[k], from the bins halved ahead of the sums
+    const auto x0     = spectrum[0].real() * half;
+    const auto x_last = spectrum[half_size].real() * half;
+    spectrum[0]       = T((x0 + x_last) * half, (x0 - x_last) * half);
+    const auto           step = std::polar(1.0, -std::numbers::pi / half_size);
+    std::complex<double> w    = step;
+    for (std::size_t k = 1; k <= half_size / 2; ++k, w *= step) {
+        const T    twiddle(w.real(), w.imag());
+        const auto x_k      = spectrum[k] * half;
+        const auto x_mirror = std::conj(spectrum[half_size - k]) * half;
+        const auto even     = x_k + x_mirror;
+        const auto odd      = (x_k - x_mirror) * twiddle;
+        const auto i_odd    = T(-odd.imag(), odd.real());
+
+        spectrum[k]             = (even + i_odd) * half;
+        spectrum[half_size - k] = std::conj(even - i_odd) * half;
+    }
+    spectrum.resize(half_size);
+
+    compute_inverse(spectrum);
+
+    for (std::size_t i = 0; i < half_size; ++i) {
+        samples[2 * i]     = spectrum[i].real() + spectrum[i].real();
+        samples[2 * i + 1] = spectrum[i].imag() + spectrum[i].imag();
+    }
+}
+
+}  // namespace fftemb
+
+#endif  // H_RFFT_HPP
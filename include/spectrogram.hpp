@@ -0,0 +1,303 @@
+/**
+ * @file spectrogram.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the batch spectrogram of raw PCM recordings, from memory or from memory-mapped files
+ */
+
+#ifndef H_SPECTROGRAM_HPP
+#define H_SPECTROGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "ingest.hpp"
+#include "mapped_file.hpp"
+#include "spectrum.hpp"
+#include "thread_pool.hpp"
+#include "window.hpp"
+
+namespace fftemb
+{
+/// @brief The integer formats of the raw PCM samples, native endianness
+enum class SampleFormat
+{
+    /// @brief 16-bit signed integers, full scale at 2^15
+    int16,
+    /// @brief 32-bit signed integers, full scale at 2^31
+    int32
+};
+
+/// @brief The values written for each bin of a spectrogram
+enum class SpectrogramScale
+{
+    /// @brief The magnitude |X|
+    magnitude,
+    /// @brief The power |X|²
+    power,
+    /// @brief The power in dB, 10 log10(|X|²), through the logarithm table of spectrum.hpp
+    db
+};
+
+/// @brief The parameters of a spectrogram
+struct SpectrogramOptions
+{
+    /// @brief The frame size (must be a power of 2)
+    std::size_t size = 1024;
+    /// @brief The number of samples between consecutive frames (must be greater than 0)
+    std::size_t hop = 256;
+    /// @brief The number of interleaved channels of the recording
+    std::size_t channels = 1;
+    /// @brief The transformed channel, from 0
+    std::size_t channel = 0;
+    /// @brief The format of the samples
+    SampleFormat format = SampleFormat::int16;
+    /// @brief The window function, applied with its coherent gain correction
+    WindowType window = WindowType::hann;
+    /// @brief The values written for each bin
+    SpectrogramScale scale = SpectrogramScale::magnitude;
+    /// @brief The sampling rate, in Hz, only recorded in the header
+    double sampling_rate = 0;
+};
+
+/// @brief The magic number of the spectrogram files
+inline constexpr std::array<char, 8> k_spectrogram_magic{'F', 'F', 'T', 'E', 'M', 'B', 'S', 'G'};
+
+/// @brief The version of the layout of the spectrogram files
+inline constexpr uint32_t k_spectrogram_version = 1;
+
+/// @brief The frames of the fixed-point types cannot exceed 2^k_spectrogram_peak_bits, half the range of Q11.20
+inline constexpr int k_spectrogram_peak_bits = 10;
+
+/// @brief The number of frames transformed by each task of the thread pool
+inline constexpr std::size_t k_spectrogram_block = 32;
+
+/**
+ * @brief The header of a spectrogram file, followed by frames x bins floats, frame after frame
+ *
+ * The header is 64 bytes, so the floats are aligned and the file can be mapped and read as an array.
+ */
+struct SpectrogramHeader
+{
+    /// @brief k_spectrogram_magic
+    std::array<char, 8> magic;
+    /// @brief k_spectrogram_version
+    uint32_t version;
+    /// @brief The frame size
+    uint32_t size;
+    /// @brief The number of samples between consecutive frames
+    uint32_t hop;
+    /// @brief The number of bins of each frame, from DC to Nyquist
+    uint32_t bins;
+    /// @brief The number of frames
+    uint64_t frames;
+    /// @brief The number of samples of the transformed channel
+    uint64_t samples;
+    /// @brief The values of the bins, a SpectrogramScale
+    uint32_t scale;
+    /// @brief The window function, a WindowType
+    uint32_t window;
+    /// @brief The sampling rate, in Hz (0 if unknown)
+    double sampling_rate;
+    /// @brief The transformed channel
+    uint32_t channel;
+    /// @brief Padding, zero
+    uint32_t reserved;
+};
+
+static_assert(sizeof(SpectrogramHeader) == 64, "the spectrogram header must keep its file layout");
+
+/// @brief The outcome of a spectrogram of a file
+enum class SpectrogramStatus
+{
+    /// @brief The spectrogram was written
+    ok,
+    /// @brief The options are invalid
+    invalid_options,
+    /// @brief The input could not be mapped
+    input_error,
+    /// @brief The output could not be created
+    output_error
+};
+
+namespace fft_utils
+{
+/**
+ * @brief Check the parameters of a spectrogram
+ *
+ * @param options The parameters
+ * @return Whether they are valid
+ */
+inline bool
+is_valid(const SpectrogramOptions& options)
+{
+    return options.size >= 2 && std::has_single_bit(options.size) && options.hop > 0 && options.channels > 0
+           && options.channel < options.channels;
+}
+
+/**
+ * @brief Get the number of frames of a spectrogram
+ *
+ * @param samples The number of samples of the channel
+ * @param options The parameters
+ * @return The number of complete frames
+ */
+inline std::size_t
+spectrogram_frames(std::size_t samples, const SpectrogramOptions& options)
+{
+    return samples < options.size ? 0 : (samples - options.size) / options.hop + 1;
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Computes the spectrogram of interleaved integer samples, frame by frame in parallel
+ *
+ * Each frame is read straight from the samples (e.g. a file mapping) by fft_utils::ingest_samples(), which shifts
+ * them to full scale and multiplies them by the window on the way into the transform buffer, the only copy. The bins
+ * from DC to Nyquist are written straight into their row of the output. Every task of the pool owns a transform
+ * buffer for a block of frames, so nothing is allocated per frame.
+ *
+ * The frames are shifted down so that they cannot exceed 2^k_spectrogram_peak_bits, and the bins are scaled back
+ * up: a full-scale sinusoid on a bin reads N/2 in magnitude whatever the type.
+ *
+ * @tparam T The complex number type of the transform
+ * @tparam Sample The integer type of the samples, int16_t or int32_t
+ * @param samples The interleaved samples
+ * @param options The parameters, which must be valid
+ * @param pool The threads transforming the frames
+ * @param[out] output The spectrogram, at least frames x (N/2 + 1) floats
+ * @return The number of frames
+ */
+template <typename T = Complex, typename Sample>
+std::size_t
+compute_spectrogram(std::span<const Sample>   samples,
+                    const SpectrogramOptions& options,
+                    ThreadPool&               pool,
+                    std::span<float>          output)
+{
+    const auto  size     = options.size;
+    const auto  bins     = size / 2 + 1;
+    const auto  frames   = fft_utils::spectrogram_frames(samples.size() / options.channels, options);
+    const int   headroom = std::max(0, std::countr_zero(size) - k_spectrogram_peak_bits);
+    const auto  shift    = fft_utils::k_full_scale_shift<Sample> + headroom;
+    const auto  scale    = std::ldexp(1.0, -headroom);
+    const auto& window   = window_table<typename T::value_type>(options.window, size);
+
+    const auto blocks = (frames + k_spectrogram_block - 1) / k_spectrogram_block;
+    pool.parallel_for(blocks, [&](std::size_t block) {
+        std::vector<T> frame(size);
+        const auto     last = std::min(frames, (block + 1) * k_spectrogram_block);
+        for (auto f = block * k_spectrogram_block; f < last; ++f) {
+            const auto first = samples.subspan(f * options.hop * options.channels + options.channel,
+                                               (size - 1) * options.channels + 1);
+            fft_utils::ingest_samples<Sample, T, std::vector>(
+                first, frame, window.data(), shift, false, options.channels);
+            compute(frame);
+
+            const Span<T> spectrum(frame.data(), bins);
+            Span<float>   row(output.data() + f * bins, bins);
+            fft_utils::power_spectrum<T, Span>(spectrum, row);
+            switch (options.scale) {
+            case SpectrogramScale::power:
+                for (auto& bin : row) {
+                    bin = static_cast<float>(bin / (scale * scale));
+                }
+                break;
+            case SpectrogramScale::db:
+                for (auto& bin : row) {
+                    bin = fft_utils::power_to_db(bin) - static_cast<float>(20 * std::log10(scale));
+                }
+                break;
+            default:
+                for (auto& bin : row) {
+                    bin = static_cast<float>(std::sqrt(bin) / scale);
+                }
+                break;
+            }
+        }
+    });
+    return frames;
+}
+
+/**
+ * @brief Computes the spectrogram of a raw PCM file into a new spectrogram file, both memory-mapped
+ *
+ * The output is created with its final size, a SpectrogramHeader then the rows, which the frames fill in place.
+ *
+ * @tparam T The complex number type of the transform
+ * @param input The path of the raw recording
+ * @param output The path of the spectrogram, overwritten
+ * @param options The parameters
+ * @param pool The threads transforming the frames
+ * @param[out] header The header written to the output
+ * @return The outcome
+ */
+template <typename T = Complex>
+SpectrogramStatus
+write_spectrogram(const char*               input,
+                  const char*               output,
+                  const SpectrogramOptions& options,
+                  ThreadPool&               pool,
+                  SpectrogramHeader&        header)
+{
+    if (!fft_utils::is_valid(options)) {
+        return SpectrogramStatus::invalid_options;
+    }
+    const MappedFile recording(input);
+    if (!recording.is_open()) {
+        return SpectrogramStatus::input_error;
+    }
+
+    const auto sample_bytes = options.format == SampleFormat::int16 ? sizeof(int16_t) : sizeof(int32_t);
+    const auto samples      = recording.size() / (sample_bytes * options.channels);
+    const auto frames       = fft_utils::spectrogram_frames(samples, options);
+    const auto bins         = options.size / 2 + 1;
+
+    header = {k_spectrogram_magic,
+              k_spectrogram_version,
+              static_cast<uint32_t>(options.size),
+              static_cast<uint32_t>(options.hop),
+              static_cast<uint32_t>(bins),
+              frames,
+              samples,
+              static_cast<uint32_t>(options.scale),
+              static_cast<uint32_t>(options.window),
+              options.sampling_rate,
+              static_cast<uint32_t>(options.channel),
+              0};
+
+    MappedFile spectrogram(output, sizeof(SpectrogramHeader) + frames * bins * sizeof(float));
+    if (!spectrogram.is_open()) {
+        return SpectrogramStatus::output_error;
+    }
+    const auto bytes = spectrogram.bytes();
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    const std::span<float> rows(reinterpret_cast<float*>(bytes.data() + sizeof(header)), frames * bins);
+
+    // the samples are read in place: a mapping is page aligned, so they are aligned too
+    const auto count = samples * options.channels;
+    if (options.format == SampleFormat::int16) {
+        compute_spectrogram<T>(std::span(reinterpret_cast<const int16_t*>(recording.bytes().data()), count),
+                               options,
+                               pool,
+                               rows);
+    }
+    else {
+        compute_spectrogram<T>(std::span(reinterpret_cast<const int32_t*>(recording.bytes().data()), count),
+                               options,
+                               pool,
+                               rows);
+    }
+    return SpectrogramStatus::ok;
+}
+
+}  // namespace fftemb
+
+#endif  // H_SPECTROGRAM_HPP
@@ -0,0 +1,187 @@
+/**
+ * @file spectrum.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the batch kernels of the power, approximate magnitude and dB spectra
+ */
+
+#ifndef H_SPECTRUM_HPP
+#define H_SPECTRUM_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include "etl/vector.h"
+#include "fft_simd.hpp"
+#include "fft_types.hpp"
+
+namespace fftemb::fft_utils
+{
+/// @brief The number of mantissa bits indexing the logarithm table
+inline constexpr int k_log2_table_bits = 8;
+
+/// @brief The alpha of the alpha-max-plus-beta-min magnitude, 2cos(π/8) / (1 + cos(π/8))
+inline constexpr float k_magnitude_alpha = 0.96043387f;
+/// @brief The beta of the alpha-max-plus-beta-min magnitude, 2sin(π/8) / (1 + cos(π/8))
+inline constexpr float k_magnitude_beta = 0.39782473f;
+/// @brief The bound of the relative error of the alpha-max-plus-beta-min magnitude
+inline constexpr double k_magnitude_error = 0.0396;
+/// @brief The bound of the absolute error of the dB spectrum, in dB
+inline constexpr double k_db_error = 0.0085;
+
+/**
+ * @brief Series of log2(1 + x), accurate to double precision in [0, 1]
+ *
+ * @param x The argument
+ * @return The base-2 logarithm of 1 + x
+ */
+constexpr double
+log2p1_series(double x)
+{
+    // log(1 + x) = 2 atanh(x / (2 + x)), whose odd series converges for every x >= 0
+    const auto z    = x / (2 + x);
+    const auto z2   = z * z;
+    double     term = z;
+    double     sum  = 0;
+    for (int n = 0; n < 20; ++n) {
+        sum += term / (2 * n + 1);
+        term *= z2;
+    }
+    return 2 * sum / std::numbers::ln2;
+}
+
+/**
+ * @brief Generates the table of log2 of the mantissas, at the midpoint of each interval
+ *
+ * @return The table of log2(1 + (i + 0.5) / 2^k_log2_table_bits)
+ */
+constexpr std::array<float, (1 << k_log2_table_bits)>
+make_log2_table()
+{
+    std::array<float, (1 << k_log2_table_bits)> table{};
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        table[i] = static_cast<float>(log2p1_series((i + 0.5) / table.size()));
+    }
+    return table;
+}
+
+/// @brief The table of log2 of the mantissas
+inline constexpr auto k_log2_table = make_log2_table();
+
+/**
+ * @brief Converts a power to dB with the logarithm table
+ *
+ * The exponent of the float is the integer part of log2(power), and the leading bits of the mantissa index its
+ * fractional part. The midpoint of each interval keeps the error within half its width, below k_db_error.
+ *
+ * @param power The power, non-negative
+ * @return 10 log10(power), or -inf for a zero power
+ */
+inline float
+power_to_db(float power)
+{
+    constexpr float k_db_per_octave = 10 * std::numbers::ln2 / std::numbers::ln10;
+    if (power < std::numeric_limits<float>::min()) {
+        return power == 0 ? -std::numeric_limits<float>::infinity() : 10 * std::log10(power);
+    }
+    const auto bits     = std::bit_cast<uint32_t>(power);
+    const auto exponent = static_cast<int>(bits >> 23) - 127;
+    const auto mantissa = (bits >> (23 - k_log2_table_bits)) & ((1u << k_log2_table_bits) - 1);
+    return k_db_per_octave * (exponent + k_log2_table[mantissa]);
+}
+
+/**
+ * @brief Calculates the power spectrum |X|², without any square root
+ *
+ * The raw integers of the Q11.20 types are squared in single precision, so the loop is a plain multiply-add over an
+ * int32 array, which the compiler vectorizes. The relative error is within 2^-22.
+ *
+ * @param spectrum The spectrum
+ * @param[out] power The power of each bin, at least as many as the bins
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+power_spectrum(const Container<T>& spectrum, Container<float>& power)
+{
+    const auto size = spectrum.size();
+    if constexpr (simd::k_is_q20_layout<T>) {
+        constexpr float k_scale = 1.0f / (1ull << (2 * simd::k_fraction_bits));
+        const auto*     raw     = reinterpret_cast<const int32_t*>(spectrum.data());
+        auto*           output  = power.data();
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto re = static_cast<float>(raw[2 * i]);
+            const auto im = static_cast<float>(raw[2 * i + 1]);
+            output[i]     = (re * re + im * im) * k_scale;
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto re = static_cast<double>(spectrum[i].real());
+            const auto im = static_cast<double>(spectrum[i].imag());
+            power[i]      = static_cast<float>(re * re + im * im);
+        }
+    }
+}
+
+/**
+ * @brief Calculates the magnitude spectrum with the alpha-max-plus-beta-min approximation
+ *
+ * |X| is approximated by alpha max(|re|, |im|) + beta min(|re|, |im|), with the coefficients that balance the error
+ * over the octant: the relative error is within ±k_magnitude_error. There is no square root nor branch, so the loop
+ * vectorizes like the power spectrum.
+ *
+ * @param spectrum The spectrum
+ * @param[out] magnitude The approximate magnitude of each bin, at least as many as the bins
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+magnitude_spectrum_approx(const Container<T>& spectrum, Container<float>& magnitude)
+{
+    const auto size = spectrum.size();
+    if constexpr (simd::k_is_q20_layout<T>) {
+        constexpr float k_scale = 1.0f / (1 << simd::k_fraction_bits);
+        constexpr float k_alpha = k_magnitude_alpha * k_scale;
+        constexpr float k_beta  = k_magnitude_beta * k_scale;
+        const auto*     raw     = reinterpret_cast<const int32_t*>(spectrum.data());
+        auto*           output  = magnitude.data();
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto re = std::abs(static_cast<float>(raw[2 * i]));
+            const auto im = std::abs(static_cast<float>(raw[2 * i + 1]));
+            output[i]     = k_alpha * std::max(re, im) + k_beta * std::min(re, im);
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto re = std::abs(static_cast<float>(static_cast<double>(spectrum[i].real())));
+            const auto im = std::abs(static_cast<float>(static_cast<double>(spectrum[i].imag())));
+            magnitude[i]  = k_magnitude_alpha * std::max(re, im) + k_magnitude_beta * std::min(re, im);
+        }
+    }
+}
+
+/**
+ * @brief Calculates the dB spectrum 10 log10(|X|²), through the logarithm table
+ *
+ * The error is within ±k_db_error on top of the power spectrum, and a zero bin gives -inf.
+ *
+ * @param spectrum The spectrum
+ * @param[out] db The power of each bin in dB, at least as many as the bins
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+db_spectrum(const Container<T>& spectrum, Container<float>& db)
+{
+    power_spectrum(spectrum, db);
+    const auto size = spectrum.size();
+    for (std::size_t i = 0; i < size; ++i) {
+        db[i] = power_to_db(db[i]);
+    }
+}
+
+}  // namespace fftemb::fft_utils
+
+#endif  // H_SPECTRUM_HPP
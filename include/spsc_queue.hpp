@@ -0,0 +1,116 @@
+/**
+ * @file spsc_queue.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the SpscQueue class
+ */
+
+#ifndef H_SPSC_QUEUE_HPP
+#define H_SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+
+namespace fftemb
+{
+/// @brief The size of a cache line, which keeps the indices of the two sides of a queue apart
+inline constexpr std::size_t k_cache_line_size = 64;
+
+/**
+ * @brief Bounded lock-free ring queue between exactly one producer thread and one consumer thread
+ *
+ * The producer only writes the tail and the consumer only writes the head, each on its own cache line, and the slots
+ * are handed over with release and acquire orderings. Each side also keeps the last index it read from the other one,
+ * so the line of the other side is only read again when the queue looks full or empty. The slots live in the object:
+ * nothing is allocated, and neither side ever blocks or waits for the other.
+ *
+ * @tparam T The type of the elements, cheap to copy (such as indices into a pool)
+ * @tparam Capacity The number of slots (must be a power of 2)
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(std::has_single_bit(Capacity), "The capacity must be a power of 2");
+
+public:
+    /**
+     * @brief Appends an element, from the producer thread
+     *
+     * @param value The element
+     * @return Whether it was appended, false if the queue is full
+     */
+    bool
+    try_push(const T& value)
+    {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cached_head == Capacity) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail - m_cached_head == Capacity) {
+                return false;
+            }
+        }
+        m_slots[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element, from the consumer thread
+     *
+     * @param[out] value The element, untouched if the queue is empty
+     * @return Whether an element was removed, false if the queue is empty
+     */
+    bool
+    try_pop(T& value)
+    {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cached_tail) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cached_tail) {
+                return false;
+            }
+        }
+        value = m_slots[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of elements, exact only from a thread that is not pushing nor popping
+     *
+     * @return The number of elements
+     */
+    std::size_t
+    size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the capacity
+     *
+     * @return The number of slots
+     */
+    static constexpr std::size_t
+    capacity()
+    {
+        return Capacity;
+    }
+
+private:
+    /// @brief The number of elements ever popped, written by the consumer
+    alignas(k_cache_line_size) std::atomic<std::size_t> m_head{0};
+    /// @brief The last tail read by the consumer
+    std::size_t m_cached_tail = 0;
+    /// @brief The number of elements ever pushed, written by the producer
+    alignas(k_cache_line_size) std::atomic<std::size_t> m_tail{0};
+    /// @brief The last head read by the producer
+    std::size_t m_cached_head = 0;
+    /// @brief The slots, indexed by the counters modulo the capacity
+    alignas(k_cache_line_size) std::array<T, Capacity> m_slots{};
+};
+
+}  // namespace fftemb
+
+#endif  // H_SPSC_QUEUE_HPP
@@ -0,0 +1,152 @@
+/**
+ * @file streaming_stft.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the StreamingStft class
+ */
+
+#ifndef H_STREAMING_STFT_HPP
+#define H_STREAMING_STFT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include "etl/vector.h"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+#include "window.hpp"
+
+namespace fftemb
+{
+/**
+ * @brief Short-time Fourier transform of a continuous stream, emitting the spectrum of the last N samples every hop
+ * samples
+ *
+ * The samples are kept in a ring buffer, and each frame is read from it directly into bit reversed order with the
+ * window applied, so overlapping frames are never copied around. All the memory is held by the object, nothing is
+ * allocated after construction.
+ *
+ * @tparam N The frame size (must be a power of 2)
+ * @tparam T The complex number type
+ */
+template <std::size_t N, typename T = Complex>
+class StreamingStft
+{
+public:
+    using Real = typename T::value_type;
+
+    /**
+     * @brief Construct a new streaming STFT
+     *
+     * @param hop The number of samples between consecutive frames, 0 being taken as 1
+     * @param window The window function, applied with its coherent gain correction
+     * @param input_scale A factor folded into the window, to keep the spectrum within the range of the type
+     */
+    explicit StreamingStft(std::size_t hop, WindowType window = WindowType::hann, double input_scale = 1);
+
+    /**
+     * @brief Appends a chunk of samples, of any size, computing every frame completed by it
+     *
+     * @param chunk The samples
+     * @param on_spectrum The callable invoked with each spectrum (an etl::ivector<T> of N bins), valid during the call
+     * @return The number of spectra emitted
+     */
+    template <template <class...> class Container, typename Callback>
+    std::size_t
+    push(const Container<T>& chunk, Callback&& on_spectrum);
+
+    /**
+     * @brief Discards the buffered samples, so that the next frame needs N new samples
+     */
+    void
+    reset();
+
+    /**
+     * @brief Get the hop size
+     *
+     * @return The number of samples between consecutive frames
+     */
+    std::size_t
+    hop() const
+    {
+        return m_hop;
+    }
+
+    /**
+     * @brief Get the frame size
+     *
+     * @return The number of samples of each frame
+     */
+    static constexpr std::size_t
+    size()
+    {
+        return N;
+    }
+
+private:
+    /// @brief The plan of the frame transform
+    FftPlan<N, T> m_plan;
+    /// @brief The window coefficients, including the coherent gain correction and the input scale
+    std::array<Real, N> m_window;
+    /// @brief The last N samples, the oldest one at m_head once full
+    std::array<T, N> m_ring;
+    /// @brief The work buffer of the frame transform
+    etl::vector<T, N> m_spectrum;
+    /// @brief The number of samples between consecutive frames
+    std::size_t m_hop;
+    /// @brief The position of the next sample in the ring buffer
+    std::size_t m_head = 0;
+    /// @brief The number of samples still missing to complete the next frame
+    std::size_t m_pending = N;
+};
+
+template <std::size_t N, typename T>
+StreamingStft<N, T>::StreamingStft(std::size_t hop, WindowType window, double input_scale)
+  : m_spectrum(N), m_hop(std::max<std::size_t>(hop, 1))
+{
+    const auto& table = window_table<Real>(window, N);
+    for (std::size_t i = 0; i < N; ++i) {
+        m_window[i] = static_cast<Real>(static_cast<double>(table[i]) * input_scale);
+    }
+    m_ring.fill(T(0, 0));
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container, typename Callback>
+std::size_t
+StreamingStft<N, T>::push(const Container<T>& chunk, Callback&& on_spectrum)
+{
+    const auto& bit_reversed = m_plan.bit_reversed_indices();
+    std::size_t emitted      = 0;
+    for (std::size_t offset = 0; offset < chunk.size();) {
+        // copy up to the end of the chunk, the end of the ring or the end of the frame, whatever comes first
+        const auto count = std::min({chunk.size() - offset, N - m_head, m_pending});
+        std::copy_n(chunk.begin() + offset, count, m_ring.begin() + m_head);
+        offset += count;
+        m_head = (m_head + count) % N;
+        m_pending -= count;
+
+        if (m_pending == 0) {
+            for (std::size_t i = 0; i < N; ++i) {
+                m_spectrum[bit_reversed[i]] = m_ring[(m_head + i) % N] * m_window[i];
+            }
+            m_plan.butterflies(m_spectrum);
+            on_spectrum(static_cast<const etl::ivector<T>&>(m_spectrum));
+            m_pending = m_hop;
+            ++emitted;
+        }
+    }
+    return emitted;
+}
+
+template <std::size_t N, typename T>
+void
+StreamingStft<N, T>::reset()
+{
+    m_ring.fill(T(0, 0));
+    m_head    = 0;
+    m_pending = N;
+}
+
+}  // namespace fftemb
+
+#endif  // H_STREAMING_STFT_HPP
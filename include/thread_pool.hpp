@@ -0,0 +1,235 @@
+/**
+ * @file thread_pool.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the ThreadPool class
+ */
+
+#ifndef H_THREAD_POOL_HPP
+#define H_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace fftemb
+{
+/**
+ * @brief Work-stealing thread pool running parallel loops
+ *
+ * Every thread owns a queue of index ranges. A loop is split in ranges spread over all the queues, and a thread
+ * whose queue runs empty steals ranges from the front of the others, so uneven ranges still balance out. The
+ * calling thread takes part in the loop, thus a pool of 1 thread runs everything on the caller.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Construct a new thread pool
+     *
+     * @param threads The number of threads running the loops, including the calling one
+     */
+    explicit ThreadPool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()));
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool&
+    operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Get the number of threads
+     *
+     * @return The number of threads running the loops, including the calling one
+     */
+    std::size_t
+    size() const
+    {
+        return m_queues.size();
+    }
+
+    /**
+     * @brief Calls a function for every index of a range, in parallel, returning once all of them are done
+     *
+     * The loops of a pool must be started by one thread at a time, though a loop may start nested ones.
+     *
+     * @param count The number of indices, from 0 to count - 1
+     * @param function The callable invoked with each index (it must not throw)
+     */
+    template <typename Function>
+    void
+    parallel_for(std::size_t count, Function&& function);
+
+private:
+    /// @brief A parallel loop, with its type erased function
+    struct Job
+    {
+        void (*invoke)(void*, std::size_t);
+        void*                    context;
+        std::atomic<std::size_t> remaining;
+    };
+
+    /// @brief A range of indices of a job
+    struct Task
+    {
+        Job*        job;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    /// @brief The queue of tasks owned by a thread
+    struct Queue
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * @brief Runs a task from the own queue, or stolen from another one
+     *
+     * @param self The index of the queue of the running thread
+     * @return Whether a task was run
+     */
+    bool
+    run_one(std::size_t self);
+
+    /**
+     * @brief The loop of the worker threads
+     *
+     * @param self The index of the queue of the worker
+     */
+    void
+    work(std::size_t self);
+
+    /// @brief The queues, the first one owned by the calling thread
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    /// @brief The worker threads
+    std::vector<std::thread> m_threads;
+    /// @brief Guards the sleeping of the threads
+    std::mutex m_mutex;
+    /// @brief Wakes the workers up on new tasks or on stop
+    std::condition_variable m_work_available;
+    /// @brief Wakes the calling thread up on a finished job
+    std::condition_variable m_job_done;
+    /// @brief The number of queued tasks
+    std::atomic<std::size_t> m_pending{0};
+    /// @brief Whether the workers must exit
+    bool m_stop = false;
+};
+
+inline ThreadPool::ThreadPool(std::size_t threads)
+{
+    for (std::size_t i = 0; i < std::max<std::size_t>(threads, 1); ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+    for (std::size_t i = 1; i < m_queues.size(); ++i) {
+        m_threads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_work_available.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+template <typename Function>
+void
+ThreadPool::parallel_for(std::size_t count, Function&& function)
+{
+    if (count == 0) {
+        return;
+    }
+    Job job{[](void* context, std::size_t index) { (*static_cast<std::remove_reference_t<Function>*>(context))(index); },
+            const_cast<void*>(static_cast<const void*>(std::addressof(function))),
+            count};
+
+    // a few ranges per thread, so that there is something left to steal
+    const auto grain = std::max<std::size_t>(1, count / (4 * size()));
+    const auto tasks = (count + grain - 1) / grain;
+    // counted before they are queued, so that a worker taking one never decrements below zero
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending += tasks;
+    }
+    for (std::size_t begin = 0, task = 0; begin < count; begin += grain, ++task) {
+        auto&                             queue = *m_queues[task % size()];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back({&job, begin, std::min(begin + grain, count)});
+    }
+    m_work_available.notify_all();
+
+    while (job.remaining > 0) {
+        if (!run_one(0)) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_done.wait(lock, [&job] { return job.remaining == 0; });
+        }
+    }
+}
+
+inline bool
+ThreadPool::run_one(std::size_t self)
+{
+    Task task{};
+    bool found = false;
+    for (std::size_t k = 0; k < size() && !found; ++k) {
+        auto&                             queue = *m_queues[(self + k) % size()];
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            // the owner takes the most recent task, thieves the oldest one
+            if (k == 0) {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            else {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    --m_pending;
+    for (auto i = task.begin; i < task.end; ++i) {
+        task.job->invoke(task.job->context, i);
+    }
+    if (task.job->remaining.fetch_sub(task.end - task.begin) == task.end - task.begin) {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_job_done.notify_all();
+    }
+    return true;
+}
+
+inline void
+ThreadPool::work(std::size_t self)
+{
+    while (true) {
+        if (run_one(self)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_work_available.wait(lock, [this] { return m_stop || m_pending > 0; });
+        if (m_stop && m_pending == 0) {
+            return;
+        }
+    }
+}
+
+}  // namespace fftemb
+
+#endif  // H_THREAD_POOL_HPP
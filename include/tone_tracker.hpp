@@ -0,0 +1,436 @@
+/**
+ * @file tone_tracker.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the Goertzel and SlidingDft classes, tracking the bins of a few known frequencies
+ */
+
+#ifndef H_TONE_TRACKER_HPP
+#define H_TONE_TRACKER_HPP
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include "fft_types.hpp"
+#include "peak_detector.hpp"
+#include "window.hpp"
+
+namespace fftemb
+{
+/// @brief The default pole radius of the sliding DFT, 1 - 2^-17, keeping the recursion stable despite the rounding
+inline constexpr double k_sliding_dft_damping = 1 - 1.0 / (1 << 17);
+
+namespace fft_utils
+{
+/**
+ * @brief Maps a frequency to its fractional bin, as find_peaks() does the other way around
+ *
+ * @param frequency The frequency, in Hz
+ * @param size The transform size
+ * @param sampling_period The sampling period of the signal
+ * @return The fractional bin, f N Ts
+ */
+inline double
+frequency_to_bin(double frequency, std::size_t size, std::chrono::nanoseconds sampling_period)
+{
+    return frequency * size * std::chrono::duration_cast<std::chrono::duration<double>>(sampling_period).count();
+}
+
+/**
+ * @brief Converts a complex number in double precision to another complex type
+ *
+ * @param value The complex number
+ * @return The complex number in the type T
+ */
+template <typename T>
+T
+from_complex(std::complex<double> value)
+{
+    using Real = typename T::value_type;
+    return T(static_cast<Real>(value.real()), static_cast<Real>(value.imag()));
+}
+
+/**
+ * @brief Describes a tracked bin as a spectral peak
+ *
+ * @param value The bin of a transform of N samples
+ * @param frequency The frequency of the bin, in Hz
+ * @param bin The fractional bin index
+ * @param size The transform size N
+ * @return The peak, with the amplitude 2|X| / N of find_peaks()
+ */
+template <typename T>
+Peak
+bin_to_peak(const T& value, double frequency, double bin, std::size_t size)
+{
+    const auto magnitude
+        = std::abs(std::complex<double>(static_cast<double>(value.real()), static_cast<double>(value.imag())));
+    return {frequency, 2 * magnitude / size, bin};
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Goertzel filters computing K bins of consecutive blocks of N samples
+ *
+ * Each bin, at any frequency and not only at the multiples of the resolution, is the output of a second order
+ * resonator, s[n] = w[n] x[n] + 2 cos(ω) s[n - 1] - s[n - 2], whose only multiplication is by a real coefficient.
+ * At the end of the block, X = e^(iω(N - 1)) s[N - 1] - e^(iωN) s[N - 2] matches the bin of compute() on the
+ * windowed block.
+ * The cost is O(K) per sample, against O(N log N) per block for the whole spectrum.
+ *
+ * The state peaks at about |X| / sin(ω), larger than the bin itself at low frequencies: the input scale must keep it
+ * within the range of the type.
+ *
+ * @tparam N The block size
+ * @tparam K The number of tracked frequencies
+ * @tparam T The complex number type
+ */
+template <std::size_t N, std::size_t K, typename T = Complex>
+class Goertzel
+{
+public:
+    using Real = typename T::value_type;
+
+    /**
+     * @brief Construct a new bank of Goertzel filters
+     *
+     * @param frequencies The tracked frequencies, in Hz
+     * @param sampling_period The sampling period of the signal
+     * @param window The window function, applied with its coherent gain correction
+     * @param input_scale A factor folded into the window, to keep the state within the range of the type
+     */
+    Goertzel(const std::array<double, K>& frequencies,
+             std::chrono::nanoseconds     sampling_period,
+             WindowType                   window      = WindowType::hann,
+             double                       input_scale = 1);
+
+    /**
+     * @brief Appends a chunk of samples, of any size, computing the bins of every block completed by it
+     *
+     * @param chunk The samples
+     * @param on_bins The callable invoked with the K bins (a const std::array<T, K>&) of each block
+     * @return The number of blocks completed
+     */
+    template <template <class...> class Container, typename Callback>
+    std::size_t
+    push(const Container<T>& chunk, Callback&& on_bins);
+
+    /**
+     * @brief Discards the samples of the current block
+     */
+    void
+    reset();
+
+    /**
+     * @brief Get the bins of the last completed block
+     *
+     * @return The K bins
+     */
+    const std::array<T, K>&
+    bins() const
+    {
+        return m_bins;
+    }
+
+    /**
+     * @brief Get a tracked bin of the last completed block as a spectral peak
+     *
+     * @param index The index of the frequency
+     * @return The peak, whose amplitude includes the input scale
+     */
+    Peak
+    tone(std::size_t index) const
+    {
+        return fft_utils::bin_to_peak(m_bins[index], m_frequencies[index], m_bin_indices[index], N);
+    }
+
+    /**
+     * @brief Get the block size
+     *
+     * @return The number of samples of each block
+     */
+    static constexpr std::size_t
+    size()
+    {
+        return N;
+    }
+
+private:
+    /// @brief The window coefficients, including the coherent gain correction and the input scale
+    std::array<Real, N> m_window;
+    /// @brief The resonator coefficients, 2 cos(ω)
+    std::array<Real, K> m_coefficients;
+    /// @brief The phases of the last state, e^(iω(N - 1))
+    std::array<T, K> m_last_phases;
+    /// @brief The phases of the state before the last one, e^(iωN)
+    std::array<T, K> m_previous_phases;
+    /// @brief The states s[n - 1]
+    std::array<T, K> m_last_states;
+    /// @brief The states s[n - 2]
+    std::array<T, K> m_previous_states;
+    /// @brief The bins of the last completed block
+    std::array<T, K> m_bins;
+    /// @brief The tracked frequencies, in Hz
+    std::array<double, K> m_frequencies;
+    /// @brief The fractional bins of the tracked frequencies
+    std::array<double, K> m_bin_indices;
+    /// @brief The number of samples of the current block
+    std::size_t m_count = 0;
+};
+
+template <std::size_t N, std::size_t K, typename T>
+Goertzel<N, K, T>::Goertzel(const std::array<double, K>& frequencies,
+                            std::chrono::nanoseconds     sampling_period,
+                            WindowType                   window,
+                            double                       input_scale)
+  : m_frequencies(frequencies)
+{
+    const auto& table = window_table<Real>(window, N);
+    for (std::size_t i = 0; i < N; ++i) {
+        m_window[i] = static_cast<Real>(static_cast<double>(table[i]) * input_scale);
+    }
+    for (std::size_t k = 0; k < K; ++k) {
+        m_bin_indices[k]     = fft_utils::frequency_to_bin(frequencies[k], N, sampling_period);
+        const auto omega     = 2 * std::numbers::pi * m_bin_indices[k] / N;
+        m_coefficients[k]    = static_cast<Real>(2 * std::cos(omega));
+        m_last_phases[k]     = fft_utils::from_complex<T>(std::polar(1.0, omega * (N - 1)));
+        m_previous_phases[k] = fft_utils::from_complex<T>(std::polar(1.0, omega * N));
+    }
+    m_bins.fill(T(0, 0));
+    reset();
+}
+
+template <std::size_t N, std::size_t K, typename T>
+template <template <class...> class Container, typename Callback>
+std::size_t
+Goertzel<N, K, T>::push(const Container<T>& chunk, Callback&& on_bins)
+{
+    std::size_t completed = 0;
+    for (const auto& sample : chunk) {
+        const auto input = sample * m_window[m_count];
+        for (std::size_t k = 0; k < K; ++k) {
+            const T state        = input + m_last_states[k] * m_coefficients[k] - m_previous_states[k];
+            m_previous_states[k] = m_last_states[k];
+            m_last_states[k]     = state;
+        }
+        if (++m_count == N) {
+            for (std::size_t k = 0; k < K; ++k) {
+                m_bins[k] = m_last_states[k] * m_last_phases[k] - m_previous_states[k] * m_previous_phases[k];
+            }
+            on_bins(static_cast<const std::array<T, K>&>(m_bins));
+            reset();
+            ++completed;
+        }
+    }
+    return completed;
+}
+
+template <std::size_t N, std::size_t K, typename T>
+void
+Goertzel<N, K, T>::reset()
+{
+    m_last_states.fill(T(0, 0));
+    m_previous_states.fill(T(0, 0));
+    m_count = 0;
+}
+
+/**
+ * @brief Sliding DFT updating K bins of the last N samples on every sample
+ *
+ * Each bin follows S[n] = x[n] - r^N e^(-iωN) x[n - N] + r e^(-iω) S[n - 1], the DFT of the last N samples updated
+ * in O(1), so the spectrum at the tracked frequencies is available with a latency of one sample instead of one frame.
+ * The pole radius r slightly below 1 keeps the rounding errors from accumulating, at the cost of weighting the
+ * oldest sample by r^(N - 1).
+ *
+ * Windows cannot be applied in the time domain, since every sample stays in the sum for N updates. As they are all
+ * sums of cosines, they are applied in the frequency domain instead: each tracked bin is combined with its
+ * neighbors at ±1, ±2... bins, 3 bins per frequency for Hann and Hamming and up to 9 for the flat-top window.
+ *
+ * @tparam N The window size
+ * @tparam K The number of tracked frequencies
+ * @tparam T The complex number type
+ */
+template <std::size_t N, std::size_t K, typename T = Complex>
+class SlidingDft
+{
+public:
+    using Real = typename T::value_type;
+
+    /// @brief The largest number of bins combined for each frequency
+    static constexpr std::size_t k_max_taps = 2 * fft_utils::k_window_terms[0].size() - 1;
+
+    /**
+     * @brief Construct a new sliding DFT, as if the stream was preceded by zeros
+     *
+     * @param frequencies The tracked frequencies, in Hz
+     * @param sampling_period The sampling period of the signal
+     * @param window The window function, applied with its coherent gain correction
+     * @param input_scale A factor applied to the samples, to keep the bins within the range of the type
+     * @param damping The pole radius r, in (0, 1]
+     */
+    SlidingDft(const std::array<double, K>& frequencies,
+               std::chrono::nanoseconds     sampling_period,
+               WindowType                   window      = WindowType::hann,
+               double                       input_scale = 1,
+               double                       damping     = k_sliding_dft_damping);
+
+    /**
+     * @brief Slides the window by one sample
+     *
+     * @param sample The new sample
+     */
+    void
+    update(const T& sample);
+
+    /**
+     * @brief Slides the window over a chunk of samples
+     *
+     * @param chunk The new samples
+     */
+    template <template <class...> class Container>
+    void
+    push(const Container<T>& chunk)
+    {
+        for (const auto& sample : chunk) {
+            update(sample);
+        }
+    }
+
+    /**
+     * @brief Clears the history, as if the stream was preceded by zeros
+     */
+    void
+    reset();
+
+    /**
+     * @brief Get a tracked bin of the last N samples, windowed
+     *
+     * @param index The index of the frequency
+     * @return The bin, as compute() would give it for the windowed samples
+     */
+    T
+    bin(std::size_t index) const;
+
+    /**
+     * @brief Get a tracked bin of the last N samples as a spectral peak
+     *
+     * @param index The index of the frequency
+     * @return The peak, whose amplitude includes the input scale
+     */
+    Peak
+    tone(std::size_t index) const
+    {
+        return fft_utils::bin_to_peak(bin(index), m_frequencies[index], m_bin_indices[index], N);
+    }
+
+    /**
+     * @brief Get the window size
+     *
+     * @return The number of samples of each DFT
+     */
+    static constexpr std::size_t
+    size()
+    {
+        return N;
+    }
+
+private:
+    /// @brief The recursion coefficients of each bin, r e^(-iω)
+    std::array<T, K * k_max_taps> m_coefficients;
+    /// @brief The window weights of each bin, times the phase e^(iω(N - 1)) aligning the oldest sample to 0
+    std::array<T, K * k_max_taps> m_weights;
+    /// @brief The states S[n] of each bin
+    std::array<T, K * k_max_taps> m_states;
+    /// @brief The coefficients of the sample leaving the window, r^N e^(-iωN), the same for all bins of a frequency
+    std::array<T, K> m_expired_coefficients;
+    /// @brief The last N samples, scaled, the oldest one at m_head
+    std::array<T, N> m_ring;
+    /// @brief The tracked frequencies, in Hz
+    std::array<double, K> m_frequencies;
+    /// @brief The fractional bins of the tracked frequencies
+    std::array<double, K> m_bin_indices;
+    /// @brief The input scale
+    Real m_input_scale;
+    /// @brief The number of bins combined for each frequency
+    std::size_t m_taps;
+    /// @brief The position of the oldest sample in the ring buffer
+    std::size_t m_head = 0;
+};
+
+template <std::size_t N, std::size_t K, typename T>
+SlidingDft<N, K, T>::SlidingDft(const std::array<double, K>& frequencies,
+                                std::chrono::nanoseconds     sampling_period,
+                                WindowType                   window,
+                                double                       input_scale,
+                                double                       damping)
+  : m_frequencies(frequencies), m_input_scale(static_cast<Real>(input_scale))
+{
+    const auto& terms = fft_utils::k_window_terms[static_cast<std::size_t>(window)];
+    std::size_t order = 0;
+    for (std::size_t j = 1; j < terms.size(); ++j) {
+        order = terms[j] != 0 ? j : order;
+    }
+    m_taps = 2 * order + 1;
+
+    for (std::size_t k = 0; k < K; ++k) {
+        m_bin_indices[k]          = fft_utils::frequency_to_bin(frequencies[k], N, sampling_period);
+        const auto omega          = 2 * std::numbers::pi * m_bin_indices[k] / N;
+        m_expired_coefficients[k] = fft_utils::from_complex<T>(std::polar(std::pow(damping, N), -omega * N));
+        for (std::size_t tap = 0; tap < m_taps; ++tap) {
+            // w(i) = a_0 - a_1 cos(x) + a_2 cos(2x) - ..., with each cosine splitting in two bins at ±j
+            const auto offset     = static_cast<int>(tap) - static_cast<int>(order);
+            const auto j          = static_cast<std::size_t>(std::abs(offset));
+            const auto sign       = j % 2 == 0 ? 1.0 : -1.0;
+            const auto weight     = j == 0 ? 1.0 : sign * terms[j] / (2 * terms[0]);
+            const auto tap_omega  = omega + 2 * std::numbers::pi * offset / N;
+            const auto index      = k * k_max_taps + tap;
+            m_coefficients[index] = fft_utils::from_complex<T>(std::polar(damping, -tap_omega));
+            m_weights[index]      = fft_utils::from_complex<T>(std::polar(weight, tap_omega * (N - 1)));
+        }
+    }
+    reset();
+}
+
+template <std::size_t N, std::size_t K, typename T>
+void
+SlidingDft<N, K, T>::update(const T& sample)
+{
+    const T input   = sample * m_input_scale;
+    const T expired = m_ring[m_head];
+    m_ring[m_head]  = input;
+    m_head          = (m_head + 1) % N;
+
+    for (std::size_t k = 0; k < K; ++k) {
+        const T difference = input - expired * m_expired_coefficients[k];
+        for (std::size_t tap = 0; tap < m_taps; ++tap) {
+            const auto index = k * k_max_taps + tap;
+            m_states[index]  = difference + m_states[index] * m_coefficients[index];
+        }
+    }
+}
+
+template <std::size_t N, std::size_t K, typename T>
+T
+SlidingDft<N, K, T>::bin(std::size_t index) const
+{
+    T sum(0, 0);
+    for (std::size_t tap = 0; tap < m_taps; ++tap) {
+        sum = sum + m_states[index * k_max_taps + tap] * m_weights[index * k_max_taps + tap];
+    }
+    return sum;
+}
+
+template <std::size_t N, std::size_t K, typename T>
+void
+SlidingDft<N, K, T>::reset()
+{
+    m_states.fill(T(0, 0));
+    m_ring.fill(T(0, 0));
+    m_head = 0;
+}
+
+}  // namespace fftemb
+
+#endif  // H_TONE_TRACKER_HPP
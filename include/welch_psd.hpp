@@ -0,0 +1,246 @@
+/**
+ * @file welch_psd.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the definition of the WelchPsd class
+ */
+
+#ifndef H_WELCH_PSD_HPP
+#define H_WELCH_PSD_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include "etl/vector.h"
+#include "fft_simd.hpp"
+#include "fft_types.hpp"
+#include "streaming_stft.hpp"
+#include "window.hpp"
+
+namespace fftemb
+{
+/// @brief The averagings of the spectra of a WelchPsd
+enum class PsdAveraging
+{
+    /// @brief The mean of all the spectra since the last reset
+    linear,
+    /// @brief An exponential moving average, each spectrum weighted by 2^-shift
+    exponential
+};
+
+namespace fft_utils
+{
+#if defined(__SIZEOF_INT128__)
+/// @brief The accumulator of the raw Q22.40 powers: 128 bits hold 2^64 spectra at the rails of Q11.20
+__extension__ using power_accumulator = unsigned __int128;
+#else
+/// @brief The accumulator of the raw Q22.40 powers, saturating past 2 spectra at the rails of Q11.20
+using power_accumulator = uint64_t;
+#endif
+}  // namespace fft_utils
+
+/**
+ * @brief Power spectral density by Welch's method: the average of the periodograms of overlapping windowed frames
+ *
+ * The frames come from a StreamingStft, so a stream is pushed in chunks of any size. The power |X|² of every bin is
+ * accumulated without any square root. For Complex and FastComplex, it is computed from the raw Q11.20 integers and
+ * kept in raw Q22.40 in a wide integer accumulator, so the per-frame post-processing is one integer multiply-accumulate
+ * pass over the bins. The other types accumulate in double.
+ *
+ * @tparam N The frame size (must be a power of 2)
+ * @tparam T The complex number type
+ */
+template <std::size_t N, typename T = Complex>
+class WelchPsd
+{
+public:
+    /// @brief The accumulator of each bin
+    using Accumulator = std::conditional_t<simd::k_is_q20_layout<T>, fft_utils::power_accumulator, double>;
+
+    /**
+     * @brief Construct a new Welch PSD
+     *
+     * @param hop The number of samples between consecutive frames (must be greater than 0), N/2 for the usual 50 %
+     * overlap
+     * @param window The window function
+     * @param averaging The averaging of the spectra
+     * @param smoothing_shift The weight 2^-smoothing_shift of each spectrum in the exponential averaging
+     * @param input_scale A factor folded into the window, to keep the spectra within the range of the type
+     */
+    explicit WelchPsd(std::size_t  hop,
+                      WindowType   window          = WindowType::hann,
+                      PsdAveraging averaging       = PsdAveraging::linear,
+                      int          smoothing_shift = 4,
+                      double       input_scale     = 1);
+
+    /**
+     * @brief Appends a chunk of samples, of any size, accumulating the power of every frame completed by it
+     *
+     * @param chunk The samples
+     * @return The number of frames accumulated
+     */
+    template <template <class...> class Container>
+    std::size_t
+    push(const Container<T>& chunk);
+
+    /**
+     * @brief Calculates the averaged power spectral density, two-sided, in units² / Hz
+     *
+     * The average power of each bin is divided by the sampling rate and by the power of the window Σw², which
+     * includes the input scale: the density of a white noise of variance σ² reads σ² Ts on every bin. For real
+     * signals, the one-sided density doubles the bins from 1 to N/2 - 1.
+     *
+     * @param[out] psd The density of each bin, at least N
+     * @param sampling_period The sampling period of the signal
+     */
+    template <template <class...> class Container>
+    void
+    density(Container<float>& psd, std::chrono::nanoseconds sampling_period) const;
+
+    /**
+     * @brief Discards the buffered samples and the accumulated spectra
+     */
+    void
+    reset();
+
+    /**
+     * @brief Get the number of spectra averaged since the last reset
+     *
+     * @return The number of frames
+     */
+    std::size_t
+    frames() const
+    {
+        return m_frames;
+    }
+
+    /**
+     * @brief Get the frame size
+     *
+     * @return The number of samples of each frame
+     */
+    static constexpr std::size_t
+    size()
+    {
+        return N;
+    }
+
+private:
+    /**
+     * @brief Accumulates the power of a spectrum
+     *
+     * @param spectrum The spectrum
+     */
+    void
+    accumulate(const etl::ivector<T>& spectrum);
+
+    /// @brief The frames, windowed and transformed
+    StreamingStft<N, T> m_stft;
+    /// @brief The accumulated power of each bin
+    std::array<Accumulator, N> m_power;
+    /// @brief The averaging of the spectra
+    PsdAveraging m_averaging;
+    /// @brief The weight of each spectrum in the exponential averaging, as a right shift
+    int m_smoothing_shift;
+    /// @brief The power of the window, Σw², with the coherent gain correction and the input scale
+    double m_window_power = 0;
+    /// @brief The number of spectra accumulated since the last reset
+    std::size_t m_frames = 0;
+};
+
+template <std::size_t N, typename T>
+WelchPsd<N, T>::WelchPsd(std::size_t  hop,
+                         WindowType   window,
+                         PsdAveraging averaging,
+                         int          smoothing_shift,
+                         double       input_scale)
+  : m_stft(hop, window, input_scale), m_averaging(averaging), m_smoothing_shift(smoothing_shift)
+{
+    for (const auto coefficient : window_table<double>(window, N)) {
+        m_window_power += coefficient * coefficient;
+    }
+    m_window_power *= input_scale * input_scale;
+    m_power.fill(0);
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+std::size_t
+WelchPsd<N, T>::push(const Container<T>& chunk)
+{
+    return m_stft.push(chunk, [this](const etl::ivector<T>& spectrum) { accumulate(spectrum); });
+}
+
+template <std::size_t N, typename T>
+void
+WelchPsd<N, T>::accumulate(const etl::ivector<T>& spectrum)
+{
+    // the first spectrum initializes the exponential average
+    const bool exponential = m_averaging == PsdAveraging::exponential && m_frames > 0;
+    const auto shift       = m_smoothing_shift;
+    ++m_frames;
+
+    if constexpr (simd::k_is_q20_layout<T>) {
+        const auto* raw = reinterpret_cast<const int32_t*>(spectrum.data());
+        for (std::size_t k = 0; k < N; ++k) {
+            // at most 2 (2^31)², from the absolute values, as the wrapping butterflies of FastComplex reach INT32_MIN
+            const auto re    = static_cast<uint64_t>(std::abs(int64_t{raw[2 * k]}));
+            const auto im    = static_cast<uint64_t>(std::abs(int64_t{raw[2 * k + 1]}));
+            const auto power = re * re + im * im;
+            if (exponential) {
+                m_power[k] = m_power[k] - (m_power[k] >> shift) + (power >> shift);
+            }
+            else if constexpr (sizeof(Accumulator) > sizeof(uint64_t)) {
+                m_power[k] += power;
+            }
+            else {
+                m_power[k] += std::min(power, std::numeric_limits<Accumulator>::max() - m_power[k]);
+            }
+        }
+    }
+    else {
+        const auto weight = std::ldexp(1.0, -shift);
+        for (std::size_t k = 0; k < N; ++k) {
+            const auto re    = static_cast<double>(spectrum[k].real());
+            const auto im    = static_cast<double>(spectrum[k].imag());
+            const auto power = re * re + im * im;
+            m_power[k]       = exponential ? m_power[k] + weight * (power - m_power[k]) : m_power[k] + power;
+        }
+    }
+}
+
+template <std::size_t N, typename T>
+template <template <class...> class Container>
+void
+WelchPsd<N, T>::density(Container<float>& psd, std::chrono::nanoseconds sampling_period) const
+{
+    const auto period = std::chrono::duration_cast<std::chrono::duration<double>>(sampling_period).count();
+    auto       scale  = period / m_window_power;
+    if (m_averaging == PsdAveraging::linear && m_frames > 0) {
+        scale /= m_frames;
+    }
+    if constexpr (simd::k_is_q20_layout<T>) {
+        scale = std::ldexp(scale, -2 * simd::k_fraction_bits);
+    }
+    for (std::size_t k = 0; k < N; ++k) {
+        psd[k] = static_cast<float>(static_cast<double>(m_power[k]) * scale);
+    }
+}
+
+template <std::size_t N, typename T>
+void
+WelchPsd<N, T>::reset()
+{
+    m_stft.reset();
+    m_power.fill(0);
+    m_frames = 0;
+}
+
+}  // namespace fftemb
+
+#endif  // H_WELCH_PSD_HPP
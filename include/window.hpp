@@ -0,0 +1,190 @@
+/**
+ * @file window.hpp
+ * @author Eduardo Vieira Falcão
+ * @brief Contains the window functions and their cached tables
+ */
+
+#ifndef H_WINDOW_HPP
+#define H_WINDOW_HPP
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <map>
+#include <mutex>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+#include "etl/vector.h"
+#include "fft_types.hpp"
+#include "instrumentation.hpp"
+
+namespace fftemb
+{
+/// @brief The window functions, all of them periodic (DFT-even)
+enum class WindowType
+{
+    /// @brief Hann, good frequency resolution and leakage for general use
+    hann,
+    /// @brief Hamming, lower first sidelobe than Hann but slower sidelobe decay
+    hamming,
+    /// @brief 4-term Blackman-Harris, -92 dB sidelobes for a wide dynamic range
+    blackman_harris,
+    /// @brief Flat-top, the most accurate amplitudes for frequencies between bins
+    flat_top,
+    /// @brief Rectangular (no window), the narrowest main lobe for tones on the bins
+    rectangular
+};
+
+namespace fft_utils
+{
+/// @brief The coefficients a_k of the sums of cosines w(i) = a_0 - a_1 cos(x) + a_2 cos(2x) - ..., by WindowType
+inline constexpr std::array<std::array<double, 5>, 5> k_window_terms{{
+    {0.5, 0.5, 0, 0, 0},
+    {0.54, 0.46, 0, 0, 0},
+    {0.35875, 0.48829, 0.14128, 0.01168, 0},
+    {0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368},
+    {1, 0, 0, 0, 0},
+}};
+
+/**
+ * @brief Computes a coefficient of a periodic window
+ *
+ * @param type The window function
+ * @param index The index of the coefficient
+ * @param size The window size
+ * @return The coefficient, without gain correction
+ */
+inline double
+window_coefficient(WindowType type, std::size_t index, std::size_t size)
+{
+    const auto& terms       = k_window_terms[static_cast<std::size_t>(type)];
+    const auto  angle       = 2 * std::numbers::pi * index / size;
+    double      coefficient = 0;
+    double      sign        = 1;
+    for (std::size_t k = 0; k < terms.size(); ++k, sign = -sign) {
+        coefficient += sign * terms[k] * std::cos(k * angle);
+    }
+    return coefficient;
+}
+
+/**
+ * @brief Fills a window table, divided by the coherent gain (the mean of the coefficients)
+ *
+ * The coherent gain correction makes the spectrum of a windowed sinusoid peak at its unwindowed amplitude.
+ *
+ * @param type The window function
+ * @param[out] table The table, whose size is the window size
+ */
+template <typename Table>
+void
+fill_window_table(WindowType type, Table& table)
+{
+    const auto          size = table.size();
+    std::vector<double> coefficients(size);
+    double              gain = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        coefficients[i] = window_coefficient(type, i, size);
+        gain += coefficients[i];
+    }
+    gain /= size;
+    for (std::size_t i = 0; i < size; ++i) {
+        table[i] = static_cast<typename Table::value_type>(coefficients[i] / gain);
+    }
+}
+}  // namespace fft_utils
+
+/**
+ * @brief Get the cached table of a window of a size known at compile time, built on the first call
+ *
+ * @tparam Type The window function
+ * @tparam N The window size
+ * @tparam Real The type of the coefficients
+ * @return The coefficients, divided by the coherent gain
+ */
+template <WindowType Type, std::size_t N, typename Real = safe_rounding_elastic_integer>
+const std::array<Real, N>&
+window_table()
+{
+    static const auto table = [] {
+        std::array<Real, N> coefficients;
+        fft_utils::fill_window_table(Type, coefficients);
+        return coefficients;
+    }();
+    return table;
+}
+
+/**
+ * @brief Get the cached table of a window, built on the first call for each (type, size) pair
+ *
+ * Each thread remembers the last table it got, so repeated calls with the same pair, as the ones of apply_window()
+ * on every frame, neither lock nor search the shared cache. The tables never move once built.
+ *
+ * @param type The window function
+ * @param size The window size
+ * @tparam Real The type of the coefficients
+ * @return The coefficients, divided by the coherent gain
+ */
+template <typename Real = safe_rounding_elastic_integer>
+const std::vector<Real>&
+window_table(WindowType type, std::size_t size)
+{
+    thread_local WindowType               last_type  = WindowType::hann;
+    thread_local std::size_t              last_size  = 0;
+    thread_local const std::vector<Real>* last_table = nullptr;
+    if (last_table != nullptr && last_type == type && last_size == size) {
+        return *last_table;
+    }
+
+    static std::mutex                                                    mutex;
+    static std::map<std::pair<WindowType, std::size_t>, std::vector<Real>> tables;
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto [it, inserted] = tables.try_emplace({type, size}, size);
+    if (inserted) {
+        fft_utils::fill_window_table(type, it->second);
+    }
+    last_type  = type;
+    last_size  = size;
+    last_table = &it->second;
+    return it->second;
+}
+
+namespace fft_utils
+{
+/**
+ * @brief Multiply a sequence by a window
+ *
+ * @param[in,out] sequence The sequence of elements
+ * @param type The window function, whose cached table is used
+ */
+template <typename T = Complex, template <class...> class Container = etl::ivector>
+void
+apply_window(Container<T>& sequence, WindowType type)
+{
+    FFTEMB_PROBE(window);
+    const auto& window = window_table<typename T::value_type>(type, sequence.size());
+    for (std::size_t i = 0; i < sequence.size(); ++i) {
+        sequence[i] = sequence[i] * window[i];
+    }
+}
+
+/**
+ * @brief Multiply a sequence by a window in place, on memory owned by the caller
+ *
+ * @param[in,out] sequence The sequence of elements
+ * @param type The window function, whose cached table is used
+ */
+template <typename T, std::size_t Extent>
+void
+apply_window(std::span<T, Extent> sequence, WindowType type)
+{
+    Span<T> view(sequence);
+    apply_window<T, Span>(view, type);
+}
+}  // namespace fft_utils
+
+}  // namespace fftemb
+
+#endif  // H_WINDOW_HPP
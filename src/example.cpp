@@ -5,13 +5,14 @@
  */
 
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include "../tests/utils/include/signal_generator.hpp"
-#include "../tests/utils/include/testing_utils.hpp"
 #include "dsp_utils.hpp"
 #include "etl/vector.h"
 #include "fft.hpp"
 #include "fft_types.hpp"
+#include "peak_detector.hpp"
 
 using namespace fftemb;
 
@@ -33,7 +34,8 @@ main()
         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::duration<double>(0.1)));
 
     // create signal container
-    etl::vector<Complex, 128> signal(128);
+    constexpr std::size_t             signal_size = 128;
+    etl::vector<Complex, signal_size> signal(signal_size);
 
     // create signal generator
     std::shared_ptr<SignalGenerator<Complex, etl::ivector>> generator
@@ -42,19 +44,16 @@ main()
     // generate sine function
     generator->generate_sine_wave(signal, parameters);
 
-    // normalize
-    auto max_amplitude = fft_utils::normalize(signal);
-
     // apply the Hann window
     fft_utils::apply_hann_window(signal);
 
-    // compute FFT
-    compute(signal);
+    // compute FFT, scaling the stages that could overflow instead of normalizing the signal
+    auto exponent = compute_block_floating_point(signal);
 
-    // calculate peak
-    auto peak_data = test_utils::find_peaks(signal, sampling_period, parameters.size());
-    std::cout << "Peak: " << peak_data[0].first * max_amplitude << std::endl
-              << "Peak freq: " << peak_data[0].second << std::endl;
+    // find the largest peak, interpolated between the bins
+    auto peaks = find_peaks<1>(signal, sampling_period);
+    std::cout << "Peak: " << std::ldexp(peaks[0].amplitude, exponent) << std::endl
+              << "Peak freq: " << peaks[0].frequency << std::endl;
 
     return 0;
 }
@@ -0,0 +1,174 @@
+/**
+ * @file spectrogram.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Command line tool computing the spectrogram of a raw PCM recording
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "fft_types.hpp"
+#include "spectrogram.hpp"
+#include "thread_pool.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+
+namespace
+{
+/**
+ * @brief Prints the usage
+ *
+ * @param program The name of the program
+ */
+void
+print_usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " <input.raw> <output.spec> [options]\n"
+              << "  --format int16|int32    sample format (default int16)\n"
+              << "  --size N                frame size, a power of 2 (default 1024)\n"
+              << "  --hop H                 samples between frames (default 256)\n"
+              << "  --channels C            interleaved channels (default 1)\n"
+              << "  --channel I             transformed channel (default 0)\n"
+              << "  --window hann|hamming|blackman-harris|flat-top|rectangular (default hann)\n"
+              << "  --scale magnitude|power|db (default magnitude)\n"
+              << "  --rate Hz               sampling rate recorded in the header\n"
+              << "  --threads T             worker threads (default: all the cores)\n";
+}
+
+/**
+ * @brief Parses the value of an option naming an enumerator
+ *
+ * @param value The value
+ * @param names The names of the enumerators, in order
+ * @param[out] result The enumerator
+ * @return Whether the value names one of them
+ */
+template <typename Enum, std::size_t Count>
+bool
+parse_name(const char* value, const char* const (&names)[Count], Enum& result)
+{
+    for (std::size_t i = 0; i < Count; ++i) {
+        if (std::strcmp(value, names[i]) == 0) {
+            result = static_cast<Enum>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Parses the value of an option holding an unsigned integer
+ *
+ * @param value The value
+ * @param[out] result The integer
+ * @return Whether the value is an unsigned integer
+ */
+bool
+parse_count(const char* value, std::size_t& result)
+{
+    char* end = nullptr;
+    result    = std::strtoull(value, &end, 10);
+    return *value != '\0' && *end == '\0';
+}
+}  // namespace
+
+/**
+ * @brief The main
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return 0 on success, 1 on invalid arguments, 2 on I/O errors
+ */
+int
+main(int argc, char** argv)
+{
+    constexpr const char* k_formats[] = {"int16", "int32"};
+    constexpr const char* k_windows[] = {"hann", "hamming", "blackman-harris", "flat-top", "rectangular"};
+    constexpr const char* k_scales[]  = {"magnitude", "power", "db"};
+
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    SpectrogramOptions options;
+    std::size_t        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 3; i < argc; i += 2) {
+        const std::string option = argv[i];
+        if (i + 1 == argc) {
+            std::cerr << "Missing value: " << option << '\n';
+            print_usage(argv[0]);
+            return 1;
+        }
+        const char* value  = argv[i + 1];
+        bool        parsed = true;
+        if (option == "--format") {
+            parsed = parse_name(value, k_formats, options.format);
+        }
+        else if (option == "--size") {
+            parsed = parse_count(value, options.size);
+        }
+        else if (option == "--hop") {
+            parsed = parse_count(value, options.hop);
+        }
+        else if (option == "--channels") {
+            parsed = parse_count(value, options.channels);
+        }
+        else if (option == "--channel") {
+            parsed = parse_count(value, options.channel);
+        }
+        else if (option == "--window") {
+            parsed = parse_name(value, k_windows, options.window);
+        }
+        else if (option == "--scale") {
+            parsed = parse_name(value, k_scales, options.scale);
+        }
+        else if (option == "--rate") {
+            options.sampling_rate = std::strtod(value, nullptr);
+        }
+        else if (option == "--threads") {
+            parsed = parse_count(value, threads) && threads > 0;
+        }
+        else {
+            parsed = false;
+        }
+        if (!parsed) {
+            std::cerr << "Invalid option: " << option << ' ' << value << '\n';
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    ThreadPool        pool(threads);
+    SpectrogramHeader header{};
+
+    const auto                          start   = std::chrono::steady_clock::now();
+    const auto                          status  = write_spectrogram(argv[1], argv[2], options, pool, header);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    switch (status) {
+    case SpectrogramStatus::invalid_options:
+        std::cerr << "Invalid options: the size must be a power of 2, the hop positive and the channel in range\n";
+        return 1;
+    case SpectrogramStatus::input_error:
+        std::cerr << "Cannot map " << argv[1] << ": " << std::strerror(errno) << '\n';
+        return 2;
+    case SpectrogramStatus::output_error:
+        std::cerr << "Cannot create " << argv[2] << ": " << std::strerror(errno) << '\n';
+        return 2;
+    default:
+        break;
+    }
+
+    const auto samples = static_cast<double>(header.samples);
+    std::cout << header.frames << " frames x " << header.bins << " bins from " << header.samples << " samples in "
+              << elapsed.count() << " s (" << samples / elapsed.count() / 1e6 << " MSamples/s, " << pool.size()
+              << " threads)\n";
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file test_convolver.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the OverlapSaveConvolver class
+ */
+
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include <vector>
+#include "convolver.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+
+using namespace fftemb;
+
+// transform size
+constexpr std::size_t k_frame_size = 1024;
+
+// error tolerance
+constexpr auto k_sample_tolerance = 1e-3;
+
+class TestOverlapSaveConvolver : public ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(TestOverlapSaveConvolver, BlocksMatchDirectConvolution)
+{
+    const auto tap_count = GetParam();
+
+    // windowed sinc low-pass, with unit gain at DC
+    std::vector<Complex> taps(tap_count);
+    std::vector<double>  reference_taps(tap_count);
+    double               gain = 0;
+    for (std::size_t i = 0; i < tap_count; ++i) {
+        const auto x      = i - (tap_count - 1) / 2.0;
+        const auto sinc   = x == 0 ? 1.0 : std::sin(0.2 * std::numbers::pi * x) / (0.2 * std::numbers::pi * x);
+        const auto window = tap_count == 1 ? 1.0 : 0.5 - 0.5 * std::cos(2 * std::numbers::pi * i / (tap_count - 1));
+        reference_taps[i] = sinc * window;
+        gain += reference_taps[i];
+    }
+    for (std::size_t i = 0; i < tap_count; ++i) {
+        reference_taps[i] /= gain;
+        taps[i] = Complex(reference_taps[i], 0);
+        reference_taps[i] = static_cast<double>(taps[i].real());
+    }
+
+    auto       convolver = std::make_unique<OverlapSaveConvolver<k_frame_size>>(taps);
+    const auto block     = convolver->block_size();
+    ASSERT_EQ(block, k_frame_size - tap_count + 1);
+
+    const std::size_t    blocks = 5;
+    std::vector<Complex> stream(blocks * block);
+    std::vector<double>  input(stream.size());
+    for (std::size_t i = 0; i < stream.size(); ++i) {
+        stream[i] = Complex(std::sin(2 * std::numbers::pi * 0.02 * i) + 0.5 * std::sin(2 * std::numbers::pi * 0.31 * i),
+                            0);
+        input[i]  = static_cast<double>(stream[i].real());
+    }
+
+    std::vector<Complex> chunk(block);
+    for (std::size_t b = 0; b < blocks; ++b) {
+        std::copy_n(stream.begin() + b * block, block, chunk.begin());
+        convolver->process(chunk);
+        for (std::size_t i = 0; i < block; ++i) {
+            const auto n         = b * block + i;
+            double     reference = 0;
+            for (std::size_t k = 0; k < tap_count && k <= n; ++k) {
+                reference += reference_taps[k] * input[n - k];
+            }
+            ASSERT_NEAR(static_cast<double>(chunk[i].real()), reference, k_sample_tolerance) << "sample " << n;
+            ASSERT_NEAR(static_cast<double>(chunk[i].imag()), 0, k_sample_tolerance) << "sample " << n;
+        }
+    }
+}
+
+TEST(TestOverlapSaveConvolverReset, ResetClearsHistory)
+{
+    std::vector<Complex> taps{Complex(0.5, 0), Complex(0.25, 0), Complex(0.25, 0)};
+    auto                 convolver = std::make_unique<OverlapSaveConvolver<64>>(taps);
+    std::vector<Complex> first(convolver->block_size(), Complex(1, 0));
+    std::vector<Complex> second(convolver->block_size(), Complex(1, 0));
+
+    convolver->process(first);
+    convolver->reset();
+    convolver->process(second);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NEAR(static_cast<double>(first[0].real()), 0.5, k_sample_tolerance);
+    EXPECT_NEAR(static_cast<double>(first[2].real()), 1, k_sample_tolerance);
+}
+
+INSTANTIATE_TEST_CASE_P(TapCounts, TestOverlapSaveConvolver, ::testing::Values(1, 31, 256, 700, k_frame_size));
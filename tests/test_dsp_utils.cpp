@@ -59,6 +59,18 @@ TEST_P(TestBitReversal, BitsAreReversed)
     EXPECT_EQ(test_signal, input_signal);
 }
 
+TEST(TestBitReversalEdges, EmptyAndSingleSequencesAreUntouched)
+{
+    std::vector<Complex> empty_signal;
+    std::vector<Complex> single_signal{{3, 0}};
+
+    fft_utils::bit_reversal(empty_signal);
+    fft_utils::bit_reversal(single_signal);
+
+    EXPECT_TRUE(empty_signal.empty());
+    EXPECT_EQ(single_signal, (std::vector<Complex>{{3, 0}}));
+}
+
 TEST_P(TestZeroPadding, SignalsArePowersOf2)
 {
     const int            signal_size = GetParam().first;
@@ -9,8 +9,11 @@
 #include <memory>
 #include <numbers>
 #include <numeric>
+#include <random>
 #include "dsp_utils.hpp"
 #include "fft.hpp"
+#include "fft_plan.hpp"
+#include "fft_tables.hpp"
 #include "fft_types.hpp"
 #include "gtest/gtest.h"
 #include "utils/include/signal_generator.hpp"
@@ -25,6 +28,7 @@ constexpr int k_buffer_size = 2048;
 // error tolerances
 constexpr auto k_peak_tolerance      = 0.17;
 constexpr auto k_frequency_tolerance = 0.05;
+constexpr auto k_dft_tolerance       = 1e-2;
 
 // signal generator
 constexpr std::chrono::nanoseconds          k_duration        = std::chrono::seconds(2);
@@ -43,26 +47,64 @@ auto pSquareWaveGenerator = std::bind(&SignalGenerator<Complex, std::vector>::ge
                                       std::placeholders::_2);
 
 class TestSinusoidFFT
-  : public ::testing::TestWithParam<
-        std::pair<std::function<void(std::vector<Complex>&, const SignalParameters&)>, SignalParameters>>
+  : public ::testing::TestWithParam<std::tuple<
+        std::pair<std::function<void(std::vector<Complex>&, const SignalParameters&)>, SignalParameters>,
+        FftKernel>>
 {
 };
 
 class TestSquareFFT
-  : public ::testing::TestWithParam<std::pair<std::function<void(std::vector<Complex>&, double)>, double>>
+  : public ::testing::TestWithParam<
+        std::tuple<std::pair<std::function<void(std::vector<Complex>&, double)>, double>, FftKernel>>
+{
+};
+
+class TestFFTKernels : public ::testing::TestWithParam<std::tuple<int, FftKernel>>
 {
 };
 
+class TestBlockFloatingPointFFT : public ::testing::TestWithParam<std::tuple<int, double>>
+{
+};
+
+/**
+ * @brief Checks that the compile-time tables are bit-exact with the ones of the run-time plan
+ *
+ * @tparam N The transform size
+ */
+template <std::size_t N>
+void
+expect_tables_match_plan()
+{
+    const auto  plan         = std::make_unique<FftPlan<N>>();
+    const auto& twiddle_rom  = fft_utils::k_twiddle_rom<N>;
+    const auto& swap_list    = fft_utils::k_bit_reversal_swaps<N>;
+    std::size_t swap_counter = 0;
+    for (std::size_t k = 0; k < N / 2; ++k) {
+        EXPECT_EQ(twiddle_rom[k], plan->twiddles()[k]) << "N = " << N << ", k = " << k;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto j = plan->bit_reversed_indices()[i];
+        if (j > i) {
+            ASSERT_LT(swap_counter, swap_list.size());
+            EXPECT_EQ(swap_list[swap_counter].first, i);
+            EXPECT_EQ(swap_list[swap_counter].second, j);
+            ++swap_counter;
+        }
+    }
+    EXPECT_EQ(swap_counter, swap_list.size());
+}
+
 TEST_P(TestSinusoidFFT, SinusoidSpectrumWithinTolerance)
 {
     std::vector<Complex> test_signal(k_buffer_size);
-    auto                 test_params       = GetParam();
+    auto                 test_params       = std::get<0>(GetParam());
     auto                 signal_parameters = test_params.second;
     test_params.first(test_signal, signal_parameters);
     auto max_peak = fft_utils::normalize(test_signal);
     fft_utils::apply_hann_window(test_signal);
 
-    compute(test_signal);
+    compute(test_signal, std::get<1>(GetParam()));
 
     auto peak_data = test_utils::find_peaks(test_signal, k_sampling_period, signal_parameters.size());
     for (auto& peak : peak_data) {
@@ -80,7 +122,7 @@ TEST_P(TestSinusoidFFT, SinusoidSpectrumWithinTolerance)
 TEST_P(TestSquareFFT, SquareWaveSpectrumWithinTolerance)
 {
     std::vector<Complex>                   test_signal(k_buffer_size);
-    auto                                   test_params = GetParam();
+    auto                                   test_params = std::get<0>(GetParam());
     std::vector<std::pair<double, double>> signal_parameters;
     auto                                   frequency = test_params.second;
     test_params.first(test_signal, frequency);
@@ -91,7 +133,7 @@ TEST_P(TestSquareFFT, SquareWaveSpectrumWithinTolerance)
         signal_parameters.emplace_back(std::make_pair(4 / (i * std::numbers::pi), i * frequency));
     }
 
-    compute(test_signal);
+    compute(test_signal, std::get<1>(GetParam()));
 
     auto peak_data = test_utils::find_peaks(test_signal, k_sampling_period, num_peaks);
     for (auto& peak : peak_data) {
@@ -106,15 +148,182 @@ TEST_P(TestSquareFFT, SquareWaveSpectrumWithinTolerance)
     }
 }
 
+TEST_P(TestFFTKernels, KernelMatchesReferenceDft)
+{
+    const auto [signal_size, kernel] = GetParam();
+    std::vector<Complex>              test_signal(signal_size);
+    std::vector<std::complex<double>> reference_signal(signal_size);
+    for (int i = 0; i < signal_size; ++i) {
+        test_signal[i] = Complex(std::sin(2 * std::numbers::pi * 3 * i / signal_size + 0.3),
+                                 0.5 * std::cos(2 * std::numbers::pi * 5 * i / signal_size));
+        reference_signal[i] = {static_cast<double>(test_signal[i].real()), static_cast<double>(test_signal[i].imag())};
+    }
+    const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+
+    compute(test_signal, kernel);
+
+    for (int i = 0; i < signal_size; ++i) {
+        EXPECT_NEAR(static_cast<double>(test_signal[i].real()), reference_spectrum[i].real(), k_dft_tolerance)
+            << "bin " << i;
+        EXPECT_NEAR(static_cast<double>(test_signal[i].imag()), reference_spectrum[i].imag(), k_dft_tolerance)
+            << "bin " << i;
+    }
+}
+
+TEST_P(TestBlockFloatingPointFFT, ScaledSpectrumMatchesReferenceDft)
+{
+    const auto [signal_size, amplitude] = GetParam();
+    std::vector<Complex>              test_signal(signal_size);
+    std::vector<std::complex<double>> reference_signal(signal_size);
+    for (int i = 0; i < signal_size; ++i) {
+        test_signal[i] = Complex(amplitude * std::sin(2 * std::numbers::pi * 3 * i / signal_size + 0.3),
+                                 amplitude / 2 * std::cos(2 * std::numbers::pi * 5 * i / signal_size));
+        reference_signal[i] = {static_cast<double>(test_signal[i].real()), static_cast<double>(test_signal[i].imag())};
+    }
+    const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+
+    const auto exponent = compute_block_floating_point(test_signal);
 
-INSTANTIATE_TEST_CASE_P(TestSinusoidSpectra,
-                        TestSinusoidFFT,
-                        ::testing::Values(std::make_pair(pSineWaveGenerator, SignalParameters{{5, 60}}),
-                                          std::make_pair(pSineWaveGenerator, SignalParameters{{5, 60}, {10, 100}}),
-                                          std::make_pair(pSineWaveGenerator,
-                                                         SignalParameters{{8, 30}, {3, 60}, {12, 90}})));
+    const auto scale = std::ldexp(1.0, exponent);
+    for (int i = 0; i < signal_size; ++i) {
+        EXPECT_NEAR(static_cast<double>(test_signal[i].real()) * scale, reference_spectrum[i].real(), k_dft_tolerance * scale)
+            << "bin " << i;
+        EXPECT_NEAR(static_cast<double>(test_signal[i].imag()) * scale, reference_spectrum[i].imag(), k_dft_tolerance * scale)
+            << "bin " << i;
+    }
+}
+
+TEST(TestBlockFloatingPointScaling, NoScalingWithinHeadroom)
+{
+    std::vector<Complex> test_signal(64, Complex(1, 0));
+
+    EXPECT_EQ(compute_block_floating_point(test_signal), 0);
+    EXPECT_EQ(static_cast<double>(test_signal[0].real()), 64);
+}
+
+TEST(TestBlockFloatingPointScaling, FullScaleRandomSignsDoNotOverflow)
+{
+    // butterflies of full-scale components of random signs need a shift of 2 bits on some stages
+    constexpr int                     signal_size = 16;
+    std::mt19937                      engine(7);
+    std::bernoulli_distribution       sign;
+    std::vector<Complex>              test_signal(signal_size);
+    std::vector<std::complex<double>> reference_signal(signal_size);
+    for (int trial = 0; trial < 256; ++trial) {
+        for (int i = 0; i < signal_size; ++i) {
+            test_signal[i]      = Complex(sign(engine) ? 2047 : -2047, sign(engine) ? 2047 : -2047);
+            reference_signal[i] = {static_cast<double>(test_signal[i].real()),
+                                   static_cast<double>(test_signal[i].imag())};
+        }
+        const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+
+        const auto exponent = compute_block_floating_point(test_signal);
+
+        const auto scale = std::ldexp(1.0, exponent);
+        for (int i = 0; i < signal_size; ++i) {
+            ASSERT_NEAR(static_cast<double>(test_signal[i].real()) * scale, reference_spectrum[i].real(), k_dft_tolerance * scale)
+                << "trial " << trial << ", bin " << i;
+            ASSERT_NEAR(static_cast<double>(test_signal[i].imag()) * scale, reference_spectrum[i].imag(), k_dft_tolerance * scale)
+                << "trial " << trial << ", bin " << i;
+        }
+    }
+}
+
+TEST(TestBlockFloatingPointScaling, UnnormalizedSinusoidPeaksWithinTolerance)
+{
+    std::vector<Complex> test_signal(k_buffer_size);
+    SignalParameters     signal_parameters{{300, 30}, {100, 60}, {500, 90}};
+    g_generator.generate_sine_wave(test_signal, signal_parameters);
+    fft_utils::apply_hann_window(test_signal);
+
+    const auto exponent = compute_block_floating_point(test_signal);
+
+    auto peak_data = test_utils::find_peaks(test_signal, k_sampling_period, signal_parameters.size());
+    for (auto& peak : peak_data) {
+        peak.first = std::ldexp(peak.first, exponent);
+    }
+    test_utils::sort_pairs(peak_data);
+    test_utils::sort_pairs(signal_parameters);
+    const auto peak_errors = test_utils::calculate_error(peak_data, signal_parameters);
+    for (const auto& error : peak_errors) {
+        EXPECT_LE(error.first, k_peak_tolerance);
+        EXPECT_LE(error.second, k_frequency_tolerance);
+    }
+}
+
+TEST(TestInverseFFT, InverseRecoversSignal)
+{
+    for (const int signal_size : {1, 2, 8, 64, 512, k_buffer_size}) {
+        std::vector<Complex> test_signal(signal_size);
+        for (int i = 0; i < signal_size; ++i) {
+            test_signal[i] = Complex(std::sin(2 * std::numbers::pi * 3 * i / signal_size + 0.3),
+                                     0.5 * std::cos(2 * std::numbers::pi * 5 * i / signal_size));
+        }
+        const auto reference_signal = test_signal;
+
+        compute(test_signal);
+        compute_inverse(test_signal);
+
+        for (int i = 0; i < signal_size; ++i) {
+            EXPECT_NEAR(static_cast<double>(test_signal[i].real()),
+                        static_cast<double>(reference_signal[i].real()),
+                        k_dft_tolerance)
+                << "N = " << signal_size << ", sample " << i;
+            EXPECT_NEAR(static_cast<double>(test_signal[i].imag()),
+                        static_cast<double>(reference_signal[i].imag()),
+                        k_dft_tolerance)
+                << "N = " << signal_size << ", sample " << i;
+        }
+    }
+}
+
+TEST(TestStaticFFT, TablesMatchPlan)
+{
+    expect_tables_match_plan<2>();
+    expect_tables_match_plan<8>();
+    expect_tables_match_plan<128>();
+    expect_tables_match_plan<1024>();
+    expect_tables_match_plan<k_buffer_size>();
+}
+
+TEST(TestStaticFFT, StaticComputeMatchesPlan)
+{
+    std::vector<Complex> test_signal(k_buffer_size);
+    g_generator.generate_sine_wave(test_signal, SignalParameters{{8, 30}, {3, 60}, {12, 90}});
+    fft_utils::normalize(test_signal);
+    fft_utils::apply_hann_window(test_signal);
+    auto reference_signal = test_signal;
+
+    compute<k_buffer_size>(test_signal);
+    std::make_unique<FftPlan<k_buffer_size>>()->execute(reference_signal);
+
+    EXPECT_EQ(test_signal, reference_signal);
+}
+
+
+const auto k_kernels = ::testing::Values(FftKernel::radix2, FftKernel::radix4, FftKernel::split_radix);
+
+INSTANTIATE_TEST_CASE_P(
+    TestSinusoidSpectra,
+    TestSinusoidFFT,
+    ::testing::Combine(::testing::Values(std::make_pair(pSineWaveGenerator, SignalParameters{{5, 60}}),
+                                         std::make_pair(pSineWaveGenerator, SignalParameters{{5, 60}, {10, 100}}),
+                                         std::make_pair(pSineWaveGenerator,
+                                                        SignalParameters{{8, 30}, {3, 60}, {12, 90}})),
+                       k_kernels));
 
 INSTANTIATE_TEST_CASE_P(TestSquareWaveSpectra,
                         TestSquareFFT,
-                        ::testing::Values(std::make_pair(pSquareWaveGenerator, 60),
-                                          std::make_pair(pSquareWaveGenerator, 90)));
\ No newline at end of file
+                        ::testing::Combine(::testing::Values(std::make_pair(pSquareWaveGenerator, 60),
+                                                             std::make_pair(pSquareWaveGenerator, 90)),
+                                           k_kernels));
+
+INSTANTIATE_TEST_CASE_P(TestKernels,
+                        TestFFTKernels,
+                        ::testing::Combine(::testing::Values(1, 2, 4, 8, 32, 64, 512, 2048),
+                                           ::testing::Values(FftKernel::radix4, FftKernel::split_radix)));
+
+INSTANTIATE_TEST_CASE_P(TestBlockFloatingPoint,
+                        TestBlockFloatingPointFFT,
+                        ::testing::Combine(::testing::Values(2, 8, 12, 64, 512, 1000, 2048),
+                                           ::testing::Values(0.5, 100.0, 1500.0)));
@@ -0,0 +1,144 @@
+/**
+ * @file test_fft_batch.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the batched multi-channel FFT
+ */
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include "fft.hpp"
+#include "fft_batch.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "utils/include/testing_utils.hpp"
+
+using namespace fftemb;
+
+// error tolerances
+constexpr auto k_dft_tolerance = 1e-2;
+
+class TestFftBatch : public ::testing::TestWithParam<std::tuple<int, int, BatchLayout>>
+{
+protected:
+    /**
+     * @brief Generates a different sinusoid for every channel
+     *
+     * @param size The number of samples of each channel
+     * @param channels The number of channels
+     * @return The channels, each one in its own container
+     */
+    static std::vector<std::vector<Complex>>
+    generate(int size, int channels)
+    {
+        std::vector<std::vector<Complex>> signals(channels, std::vector<Complex>(size));
+        for (int c = 0; c < channels; ++c) {
+            for (int i = 0; i < size; ++i) {
+                signals[c][i] = Complex(std::sin(2 * std::numbers::pi * (c + 1) * i / size + 0.1 * c),
+                                        0.5 * std::cos(2 * std::numbers::pi * (2 * c + 3) * i / size));
+            }
+        }
+        return signals;
+    }
+
+    /**
+     * @brief Lays out a set of channels as a batch
+     *
+     * @param signals The channels
+     * @param layout The memory layout of the batch
+     * @return The batch
+     */
+    static std::vector<Complex>
+    to_batch(const std::vector<std::vector<Complex>>& signals, BatchLayout layout)
+    {
+        const auto           channels = signals.size();
+        const auto           size     = signals[0].size();
+        std::vector<Complex> batch(channels * size);
+        for (std::size_t c = 0; c < channels; ++c) {
+            for (std::size_t i = 0; i < size; ++i) {
+                batch[layout == BatchLayout::channel_minor ? i * channels + c : c * size + i] = signals[c][i];
+            }
+        }
+        return batch;
+    }
+};
+
+TEST_P(TestFftBatch, BatchMatchesComputePerChannel)
+{
+    const auto [size, channels, layout] = GetParam();
+    auto signals                        = generate(size, channels);
+    auto batch                          = to_batch(signals, layout);
+
+    compute_batch(batch, channels, layout);
+    for (auto& signal : signals) {
+        compute(signal);
+    }
+
+    EXPECT_EQ(batch, to_batch(signals, layout));
+}
+
+TEST_P(TestFftBatch, GenericStagesMatchReferenceDft)
+{
+    const auto [size, channels, layout] = GetParam();
+    const auto signals                  = generate(size, channels);
+    auto       batch                    = to_batch(signals, layout);
+
+    fft_utils::batch_bit_reversal(batch, size, channels, layout);
+    fft_utils::batch_radix2_stages(batch, size, channels, layout);
+
+    for (int c = 0; c < channels; ++c) {
+        std::vector<std::complex<double>> reference_signal;
+        for (const auto& sample : signals[c]) {
+            reference_signal.emplace_back(static_cast<double>(sample.real()), static_cast<double>(sample.imag()));
+        }
+        const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+        for (int k = 0; k < size; ++k) {
+            const auto& bin = batch[layout == BatchLayout::channel_minor ? k * channels + c : c * size + k];
+            EXPECT_NEAR(static_cast<double>(bin.real()), reference_spectrum[k].real(), k_dft_tolerance)
+                << "channel " << c << ", bin " << k;
+            EXPECT_NEAR(static_cast<double>(bin.imag()), reference_spectrum[k].imag(), k_dft_tolerance)
+                << "channel " << c << ", bin " << k;
+        }
+    }
+}
+
+TEST(FftBatchSizes, NonPowerOf2SizesMatchComputePerChannel)
+{
+    constexpr std::size_t size     = 12;
+    constexpr std::size_t channels = 3;
+    for (const auto layout : {BatchLayout::channel_minor, BatchLayout::channel_major}) {
+        std::vector<std::vector<Complex>> signals(channels, std::vector<Complex>(size));
+        std::vector<Complex>              batch(channels * size);
+        for (std::size_t c = 0; c < channels; ++c) {
+            for (std::size_t i = 0; i < size; ++i) {
+                signals[c][i] = Complex(std::sin(2 * std::numbers::pi * (c + 1) * i / size), 0.25 * c);
+                batch[layout == BatchLayout::channel_minor ? i * channels + c : c * size + i] = signals[c][i];
+            }
+        }
+
+        compute_batch(batch, channels, layout);
+
+        for (std::size_t c = 0; c < channels; ++c) {
+            compute(signals[c]);
+            for (std::size_t k = 0; k < size; ++k) {
+                EXPECT_EQ(batch[layout == BatchLayout::channel_minor ? k * channels + c : c * size + k], signals[c][k])
+                    << "channel " << c << ", bin " << k;
+            }
+        }
+    }
+}
+
+TEST(FftBatchSizes, NoChannelLeavesTheBatchUntouched)
+{
+    std::vector<Complex> batch(8, Complex(0.5, 0));
+
+    compute_batch(batch, 0);
+
+    EXPECT_EQ(batch, std::vector<Complex>(8, Complex(0.5, 0)));
+}
+
+INSTANTIATE_TEST_CASE_P(BatchSizes,
+                        TestFftBatch,
+                        ::testing::Combine(::testing::Values(1, 2, 8, 256),
+                                           ::testing::Values(1, 3, 16),
+                                           ::testing::Values(BatchLayout::channel_minor, BatchLayout::channel_major)));
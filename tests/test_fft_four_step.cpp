@@ -0,0 +1,58 @@
+/**
+ * @file test_fft_four_step.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the four-step FFT
+ */
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include "fft.hpp"
+#include "fft_four_step.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "thread_pool.hpp"
+
+using namespace fftemb;
+
+// error tolerances
+constexpr auto k_bin_tolerance = 1e-3;
+
+class TestFourStepFFT : public ::testing::TestWithParam<std::tuple<int, std::size_t>>
+{
+};
+
+TEST_P(TestFourStepFFT, MatchesCompute)
+{
+    const auto [signal_size, threads] = GetParam();
+    // keeps the spectrum within the fixed-point range
+    const auto           amplitude = std::min(1.0, 1024.0 / signal_size);
+    std::vector<Complex> test_signal(signal_size);
+    for (int i = 0; i < signal_size; ++i) {
+        test_signal[i] = Complex(amplitude * std::sin(2 * std::numbers::pi * 7 * i / signal_size + 0.2),
+                                 amplitude * std::cos(2 * std::numbers::pi * 3 * i / signal_size) / 2);
+    }
+    auto       reference_signal = test_signal;
+    auto       scratch          = test_signal;
+    ThreadPool pool(threads);
+
+    compute_four_step(test_signal, scratch, pool);
+    compute(reference_signal);
+
+    ASSERT_EQ(test_signal.size(), reference_signal.size());
+    for (int k = 0; k < signal_size; ++k) {
+        EXPECT_NEAR(static_cast<double>(test_signal[k].real()),
+                    static_cast<double>(reference_signal[k].real()),
+                    k_bin_tolerance)
+            << "bin " << k;
+        EXPECT_NEAR(static_cast<double>(test_signal[k].imag()),
+                    static_cast<double>(reference_signal[k].imag()),
+                    k_bin_tolerance)
+            << "bin " << k;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(FourStepSizes,
+                        TestFourStepFFT,
+                        ::testing::Combine(::testing::Values(0, 1, 2, 4, 8, 32, 1000, 1024, 1 << 15, 1 << 18),
+                                           ::testing::Values(1, 3, 8)));
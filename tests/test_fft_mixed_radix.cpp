@@ -0,0 +1,106 @@
+/**
+ * @file test_fft_mixed_radix.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the MixedRadixPlan class
+ */
+
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include <vector>
+#include "etl/vector.h"
+#include "fft.hpp"
+#include "fft_mixed_radix.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "utils/include/testing_utils.hpp"
+
+using namespace fftemb;
+
+// error tolerance
+constexpr auto k_dft_tolerance = 1e-2;
+
+class TestMixedRadixPlan : public ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST(TestMixedRadixFactors, SizesAreFactorized)
+{
+    EXPECT_EQ(fft_utils::factorize(1500), (std::vector<std::size_t>{4, 3, 5, 5, 5}));
+    EXPECT_EQ(fft_utils::factorize(1001), (std::vector<std::size_t>{7, 11, 13}));
+    EXPECT_EQ(fft_utils::factorize(2018), (std::vector<std::size_t>{2, 1009}));
+    EXPECT_TRUE(fft_utils::factorize(0).empty());
+    EXPECT_TRUE(fft_utils::factorize(1).empty());
+    EXPECT_EQ(fft_utils::next_smooth_size(2017), 2025);
+    EXPECT_FALSE(std::make_unique<MixedRadixPlan<>>(1500)->uses_bluestein());
+    EXPECT_TRUE(std::make_unique<MixedRadixPlan<>>(1009)->uses_bluestein());
+}
+
+TEST_P(TestMixedRadixPlan, PlanMatchesReferenceDft)
+{
+    const auto                        signal_size = GetParam();
+    std::vector<Complex>              test_signal(signal_size);
+    std::vector<std::complex<double>> reference_signal(signal_size);
+    for (std::size_t i = 0; i < signal_size; ++i) {
+        test_signal[i] = Complex(std::sin(2 * std::numbers::pi * 3 * i / signal_size + 0.3),
+                                 0.5 * std::cos(2 * std::numbers::pi * 5 * i / signal_size));
+        reference_signal[i] = {static_cast<double>(test_signal[i].real()), static_cast<double>(test_signal[i].imag())};
+    }
+    const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+
+    std::make_unique<MixedRadixPlan<>>(signal_size)->execute(test_signal);
+
+    for (std::size_t i = 0; i < signal_size; ++i) {
+        EXPECT_NEAR(static_cast<double>(test_signal[i].real()), reference_spectrum[i].real(), k_dft_tolerance)
+            << "bin " << i;
+        EXPECT_NEAR(static_cast<double>(test_signal[i].imag()), reference_spectrum[i].imag(), k_dft_tolerance)
+            << "bin " << i;
+    }
+}
+
+TEST(TestMixedRadixCompute, ComputeKeepsNativeSize)
+{
+    constexpr std::size_t      signal_size = 1500;
+    etl::vector<Complex, 1500> test_signal(signal_size, Complex(0, 0));
+    std::vector<Complex>       reference_signal(signal_size, Complex(0, 0));
+    for (std::size_t i = 0; i < signal_size; ++i) {
+        test_signal[i] = reference_signal[i] = Complex(0.5 * std::sin(2 * std::numbers::pi * 60 * i / signal_size), 0);
+    }
+
+    compute(test_signal);
+    std::make_unique<MixedRadixPlan<>>(signal_size)->execute(reference_signal);
+
+    ASSERT_EQ(test_signal.size(), signal_size);
+    EXPECT_TRUE(std::equal(test_signal.begin(), test_signal.end(), reference_signal.begin()));
+    EXPECT_NEAR(static_cast<double>(test_signal[60].imag()), 0.25 * signal_size, k_dft_tolerance);
+}
+
+TEST(TestMixedRadixCompute, PlansAreCachedBySize)
+{
+    auto& plan = mixed_radix_plan(1500);
+
+    EXPECT_EQ(plan.size(), 1500u);
+    EXPECT_EQ(&mixed_radix_plan(1500), &plan);
+    EXPECT_NE(&mixed_radix_plan(1009), &plan);
+    EXPECT_EQ(&mixed_radix_plan(1500), &plan);
+}
+
+TEST(TestMixedRadixCompute, EmptyAndSingleSignalsAreLeftUntouched)
+{
+    std::vector<Complex> empty_signal;
+    std::vector<Complex> scratch;
+    std::vector<Complex> single_signal(1, Complex(0.5, -0.25));
+
+    compute(empty_signal);
+    compute_stockham(empty_signal, scratch);
+    EXPECT_EQ(compute_block_floating_point(empty_signal), 0);
+    compute(single_signal);
+
+    EXPECT_TRUE(empty_signal.empty());
+    EXPECT_EQ(single_signal[0], Complex(0.5, -0.25));
+}
+
+INSTANTIATE_TEST_CASE_P(TestMixedRadixSizes,
+                        TestMixedRadixPlan,
+                        ::testing::Values(1, 3, 5, 6, 7, 12, 15, 45, 100, 1001, 1500, 17, 97, 1009, 2018));
@@ -0,0 +1,187 @@
+/**
+ * @file test_fft_pipeline.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the FftPipeline and LatencyHistogram classes
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <thread>
+#include <vector>
+#include "fft_pipeline.hpp"
+#include "gtest/gtest.h"
+
+using namespace fftemb;
+
+// frame size and pool size
+constexpr std::size_t k_frame_size = 1024;
+constexpr std::size_t k_pool_size  = 8;
+
+// sampling period
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::microseconds(100);
+
+// error tolerances
+constexpr auto k_frequency_tolerance = 0.5;
+constexpr auto k_amplitude_tolerance = 0.025;
+
+using Pipeline = FftPipeline<k_frame_size, int16_t, Complex, 4, k_pool_size>;
+
+/**
+ * @brief Generates the ADC readings of a frame: a sinusoid whose frequency depends on the frame, over a DC offset
+ *
+ * @param frame The index of the frame
+ * @return The samples
+ */
+std::vector<int16_t>
+make_frame(std::size_t frame)
+{
+    const auto           frequency = 500.0 + 10 * (frame % 50);
+    std::vector<int16_t> samples(k_frame_size);
+    for (std::size_t i = 0; i < k_frame_size; ++i) {
+        const auto phase = 2 * std::numbers::pi * frequency * i * 1e-4;
+        samples[i]       = static_cast<int16_t>(std::lround(1000 + 16384 * std::sin(phase)));
+    }
+    return samples;
+}
+
+/**
+ * @brief Polls a pipeline until it has handed over a number of frames, or a second has passed
+ *
+ * @param pipeline The pipeline
+ * @param count The number of frames
+ * @param on_frame The callable invoked with each frame
+ */
+template <typename Callback>
+void
+drain(Pipeline& pipeline, uint64_t count, Callback&& on_frame)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (pipeline.completed() < count && std::chrono::steady_clock::now() < deadline) {
+        if (pipeline.poll(on_frame) == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+class TestFftPipeline : public ::testing::TestWithParam<int>
+{
+};
+
+TEST_P(TestFftPipeline, FindsThePeakOfEveryFrameInOrder)
+{
+    PipelineOptions options;
+    options.sampling_period = k_sampling_period;
+    options.cpus.fill(GetParam());
+    Pipeline pipeline(options);
+
+    constexpr uint64_t frames   = 200;
+    uint64_t           expected = 0;
+    const auto         check    = [&expected](const Pipeline::Frame& frame) {
+        EXPECT_EQ(frame.sequence, expected);
+        ASSERT_FALSE(frame.peaks.empty());
+        EXPECT_NEAR(frame.peaks[0].frequency, 500.0 + 10 * (frame.sequence % 50), k_frequency_tolerance);
+        EXPECT_NEAR(frame.peaks[0].amplitude, 0.5, k_amplitude_tolerance);
+        ++expected;
+    };
+    for (uint64_t frame = 0; frame < frames; ++frame) {
+        const auto samples = make_frame(frame);
+        // the pool is smaller than the run: wait for a free frame, as a producer with a paced ADC would
+        while (!pipeline.submit(std::span<const int16_t, k_frame_size>(samples.data(), k_frame_size))) {
+            if (pipeline.poll(check) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    drain(pipeline, frames, check);
+
+    EXPECT_EQ(pipeline.completed(), frames);
+    EXPECT_EQ(expected, frames);
+    EXPECT_EQ(pipeline.submitted() - pipeline.dropped(), frames);
+    EXPECT_EQ(pipeline.end_to_end_latency().count(), frames);
+    for (std::size_t stage = 0; stage < k_pipeline_stages; ++stage) {
+        const auto& latency = pipeline.latency(static_cast<PipelineStage>(stage));
+        EXPECT_EQ(latency.count(), frames) << k_pipeline_stage_names[stage];
+        EXPECT_LE(latency.percentile(0.99), pipeline.end_to_end_latency().max()) << k_pipeline_stage_names[stage];
+    }
+}
+
+// unpinned, and pinned to the first CPU
+INSTANTIATE_TEST_CASE_P(FftPipelineTests, TestFftPipeline, ::testing::Values(-1, 0));
+
+TEST(FftPipelineFlow, DropsTheFramesSubmittedWithoutAFreeOne)
+{
+    Pipeline   pipeline;
+    const auto samples = make_frame(0);
+    const auto frame   = std::span<const int16_t, k_frame_size>(samples.data(), k_frame_size);
+
+    // nothing is polled, so the pool runs empty after its frames
+    for (std::size_t i = 0; i < k_pool_size + 5; ++i) {
+        EXPECT_EQ(pipeline.submit(frame), i < k_pool_size);
+    }
+    EXPECT_EQ(pipeline.submitted(), k_pool_size + 5);
+    EXPECT_EQ(pipeline.dropped(), 5u);
+    EXPECT_TRUE(pipeline.pinned());
+
+    drain(pipeline, k_pool_size, [](const Pipeline::Frame&) {});
+    EXPECT_EQ(pipeline.completed(), k_pool_size);
+    EXPECT_TRUE(pipeline.submit(frame));
+}
+
+TEST(FftPipelineFlow, IdleWorkersWakeUpForTheNextFrame)
+{
+    // sleeping with a backoff, and spinning without sleeping
+    for (const auto idle_sleep : {std::chrono::microseconds(100), std::chrono::microseconds(0)}) {
+        PipelineOptions options;
+        options.idle_sleep = idle_sleep;
+        Pipeline   pipeline(options);
+        const auto samples = make_frame(0);
+        const auto frame   = std::span<const int16_t, k_frame_size>(samples.data(), k_frame_size);
+
+        for (uint64_t count = 1; count <= 3; ++count) {
+            // long enough for the workers to run out of spins and yields
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            EXPECT_TRUE(pipeline.submit(frame));
+            drain(pipeline, count, [](const Pipeline::Frame&) {});
+            EXPECT_EQ(pipeline.completed(), count) << idle_sleep.count() << " us";
+        }
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesAreWithinABucket)
+{
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+
+    EXPECT_EQ(histogram.count(), 1000u);
+    EXPECT_EQ(histogram.max(), std::chrono::microseconds(1000));
+    EXPECT_EQ(histogram.mean(), std::chrono::nanoseconds(500500));
+    for (const auto fraction : {0.01, 0.5, 0.9, 0.99}) {
+        const auto expected = 1000 * fraction * 1000;
+        const auto measured = static_cast<double>(histogram.percentile(fraction).count());
+        EXPECT_GE(measured, expected);
+        EXPECT_LE(measured, 1.125 * expected);
+    }
+    EXPECT_EQ(histogram.percentile(1), histogram.max());
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.percentile(0.99), std::chrono::nanoseconds(0));
+}
+
+TEST(LatencyHistogramTest, BucketsCoverEveryValue)
+{
+    for (const uint64_t value : {0ull, 7ull, 8ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, ~0ull}) {
+        const auto index = LatencyHistogram::bucket(value);
+        ASSERT_LT(index, LatencyHistogram::k_buckets);
+        EXPECT_GE(LatencyHistogram::upper_bound(index), value);
+        EXPECT_LE(LatencyHistogram::upper_bound(index) - value, value / 8);
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::upper_bound(index - 1), value);
+        }
+    }
+}
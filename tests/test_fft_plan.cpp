@@ -0,0 +1,122 @@
+/**
+ * @file test_fft_plan.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the FftPlan class
+ */
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <numbers>
+#include <numeric>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "utils/include/signal_generator.hpp"
+#include "utils/include/testing_utils.hpp"
+
+using SignalParameters = std::vector<std::pair<double, double>>;
+using namespace fftemb;
+
+// buffer size
+constexpr int k_buffer_size = 2048;
+
+// error tolerances
+constexpr auto k_peak_tolerance      = 0.17;
+constexpr auto k_frequency_tolerance = 0.05;
+constexpr auto k_bin_tolerance       = 1e-3;
+
+// signal generator
+constexpr std::chrono::nanoseconds          k_duration        = std::chrono::seconds(2);
+constexpr std::chrono::nanoseconds          k_sampling_period = std::chrono::milliseconds(1);
+const SignalGenerator<Complex, std::vector> g_generator
+    = SignalGenerator<Complex, std::vector>(k_duration, k_sampling_period);
+
+class TestFftPlan : public ::testing::TestWithParam<SignalParameters>
+{
+};
+
+TEST(TestFftPlanTables, BitReversalTableMatchesBitReversal)
+{
+    const auto           plan = std::make_unique<FftPlan<256>>();
+    std::vector<Complex> test_signal;
+    for (std::size_t i = 0; i < plan->size(); ++i) {
+        test_signal.emplace_back(Complex(static_cast<double>(i), 0));
+    }
+
+    fft_utils::bit_reversal(test_signal);
+
+    for (std::size_t i = 0; i < plan->size(); ++i) {
+        EXPECT_EQ(test_signal[i], Complex(plan->bit_reversed_indices()[i], 0));
+    }
+}
+
+TEST(TestFftPlanInverse, InverseMatchesCompute)
+{
+    std::vector<Complex> test_signal(k_buffer_size);
+    g_generator.generate_sine_wave(test_signal, SignalParameters{{8, 30}, {3, 60}, {12, 90}});
+    fft_utils::normalize(test_signal);
+    const auto plan = std::make_unique<FftPlan<k_buffer_size>>();
+    plan->execute(test_signal);
+    auto reference_signal = test_signal;
+
+    plan->execute_inverse(test_signal);
+    compute_inverse(reference_signal);
+
+    EXPECT_EQ(test_signal, reference_signal);
+}
+
+TEST_P(TestFftPlan, PlanMatchesCompute)
+{
+    std::vector<Complex> test_signal(k_buffer_size);
+    g_generator.generate_sine_wave(test_signal, GetParam());
+    fft_utils::normalize(test_signal);
+    fft_utils::apply_hann_window(test_signal);
+    auto reference_signal = test_signal;
+
+    const auto plan = std::make_unique<FftPlan<k_buffer_size>>();
+    plan->execute(test_signal);
+    compute(reference_signal);
+
+    for (int i = 0; i < k_buffer_size; ++i) {
+        EXPECT_NEAR(static_cast<double>(test_signal[i].real()),
+                    static_cast<double>(reference_signal[i].real()),
+                    k_bin_tolerance * k_buffer_size);
+        EXPECT_NEAR(static_cast<double>(test_signal[i].imag()),
+                    static_cast<double>(reference_signal[i].imag()),
+                    k_bin_tolerance * k_buffer_size);
+    }
+}
+
+TEST_P(TestFftPlan, SinusoidSpectrumWithinTolerance)
+{
+    std::vector<Complex> test_signal(k_buffer_size);
+    auto                 signal_parameters = GetParam();
+    g_generator.generate_sine_wave(test_signal, signal_parameters);
+    auto max_peak = fft_utils::normalize(test_signal);
+    fft_utils::apply_hann_window(test_signal);
+
+    const auto plan = std::make_unique<FftPlan<k_buffer_size>>();
+    plan->execute(test_signal);
+
+    auto peak_data = test_utils::find_peaks(test_signal, k_sampling_period, signal_parameters.size());
+    for (auto& peak : peak_data) {
+        peak.first *= max_peak;
+    }
+    test_utils::sort_pairs(peak_data);
+    test_utils::sort_pairs(signal_parameters);
+    const auto peak_errors = test_utils::calculate_error(peak_data, signal_parameters);
+    for (const auto& error : peak_errors) {
+        EXPECT_LE(error.first, k_peak_tolerance);
+        EXPECT_LE(error.second, k_frequency_tolerance);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(TestPlanSpectra,
+                        TestFftPlan,
+                        ::testing::Values(SignalParameters{{5, 60}},
+                                          SignalParameters{{5, 60}, {10, 100}},
+                                          SignalParameters{{8, 30}, {3, 60}, {12, 90}}));
@@ -0,0 +1,114 @@
+/**
+ * @file test_fft_pruned.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the PrunedFft class
+ */
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <tuple>
+#include <vector>
+#include "fft.hpp"
+#include "fft_plan.hpp"
+#include "fft_pruned.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+
+using namespace fftemb;
+
+// transform size
+constexpr std::size_t k_size = 1024;
+
+// error tolerances
+constexpr auto k_double_tolerance = 1e-9;
+
+/**
+ * @brief Generates two sinusoids whose spectrum fits in the fixed-point range
+ *
+ * @param size The number of samples
+ * @return The signal
+ */
+template <typename T = Complex>
+std::vector<T>
+generate(std::size_t size)
+{
+    std::vector<T> signal(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        signal[i] = T(std::sin(2 * std::numbers::pi * 37.3 * i / size + 0.2),
+                      std::cos(2 * std::numbers::pi * 301 * i / size) / 2);
+    }
+    return signal;
+}
+
+class TestPrunedFFT : public ::testing::TestWithParam<std::tuple<std::size_t, std::size_t>>
+{
+};
+
+TEST_P(TestPrunedFFT, MatchesTheBinsOfFftPlan)
+{
+    const auto [first, count] = GetParam();
+    auto       signal         = generate(k_size);
+    auto       reference      = signal;
+
+    PrunedFft<k_size>(first, count).execute(signal);
+    FftPlan<k_size>().execute(reference);
+
+    // the same butterflies in the same order: the bins of the band are bit exact
+    for (std::size_t t = 0; t < count; ++t) {
+        const auto k = (first + t) % k_size;
+        EXPECT_EQ(static_cast<double>(signal[k].real()), static_cast<double>(reference[k].real())) << "bin " << k;
+        EXPECT_EQ(static_cast<double>(signal[k].imag()), static_cast<double>(reference[k].imag())) << "bin " << k;
+    }
+}
+
+TEST_P(TestPrunedFFT, FloatingPointMatchesCompute)
+{
+    const auto [first, count] = GetParam();
+    auto       signal         = generate<std::complex<double>>(k_size);
+    auto       reference      = signal;
+
+    PrunedFft<k_size, std::complex<double>>(first, count).execute(signal);
+    compute(reference);
+
+    for (std::size_t t = 0; t < count; ++t) {
+        const auto k = (first + t) % k_size;
+        EXPECT_NEAR(signal[k].real(), reference[k].real(), k_double_tolerance) << "bin " << k;
+        EXPECT_NEAR(signal[k].imag(), reference[k].imag(), k_double_tolerance) << "bin " << k;
+    }
+}
+
+TEST_P(TestPrunedFFT, SkipsTheButterfliesOutsideTheBand)
+{
+    const auto [first, count] = GetParam();
+    const PrunedFft<k_size> pruned(first, count);
+    const auto              full = k_size / 2 * 10;
+
+    EXPECT_LE(pruned.multiplies(), full);
+    EXPECT_LE(pruned.multiplies(), k_size / 2 * std::log2(2 * count) + k_size);
+    if (count <= k_size / 4) {
+        EXPECT_LT(pruned.multiplies(), full);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(PrunedFftTests,
+                        TestPrunedFFT,
+                        ::testing::Values(std::make_tuple(0, 1),
+                                          std::make_tuple(0, 16),
+                                          std::make_tuple(290, 24),
+                                          std::make_tuple(17, 37),
+                                          std::make_tuple(1000, 48),
+                                          std::make_tuple(256, 512),
+                                          std::make_tuple(0, 1024)));
+
+TEST(PrunedFftBand, WrapsAndClampsTheBand)
+{
+    const PrunedFft<16> wrapped(18, 40);
+    const PrunedFft<16> empty(3, 0);
+
+    EXPECT_EQ(wrapped.first(), 2u);
+    EXPECT_EQ(wrapped.count(), 16u);
+    EXPECT_EQ(wrapped.multiplies(), 8u * 4);
+    EXPECT_EQ(empty.count(), 1u);
+    EXPECT_EQ(empty.multiplies(), 15u);
+}
@@ -0,0 +1,184 @@
+/**
+ * @file test_fft_simd.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the SIMD engine on raw Q11.20 integers
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_simd.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "utils/include/testing_utils.hpp"
+
+using namespace fftemb;
+using simd::Isa;
+
+// error tolerances
+constexpr int32_t k_lsb_tolerance = 1;
+constexpr auto    k_dft_tolerance = 1e-2;
+
+/**
+ * @brief Generates random interleaved raw values
+ *
+ * @param size The number of complex values
+ * @param amplitude The largest magnitude of the raw values
+ * @return The raw values
+ */
+std::vector<int32_t>
+random_raw_signal(int size, int32_t amplitude)
+{
+    std::mt19937                           generator(size);
+    std::uniform_int_distribution<int32_t> distribution(-amplitude, amplitude);
+    std::vector<int32_t>                   raw(2 * size);
+    for (auto& value : raw) {
+        value = distribution(generator);
+    }
+    return raw;
+}
+
+/**
+ * @brief Converts a fixed-point value to its raw Q11.20 integer
+ */
+int32_t
+to_raw(safe_rounding_elastic_integer value)
+{
+    return static_cast<int32_t>(std::llround(std::ldexp(static_cast<double>(value), simd::k_fraction_bits)));
+}
+
+/**
+ * @brief Converts a raw Q11.20 integer to its fixed-point value
+ */
+safe_rounding_elastic_integer
+from_raw(int32_t raw)
+{
+    return safe_rounding_elastic_integer{std::ldexp(raw, -simd::k_fraction_bits)};
+}
+
+class TestFftSimd : public ::testing::TestWithParam<std::tuple<int, Isa>>
+{
+protected:
+    void
+    SetUp() override
+    {
+        if (std::get<1>(GetParam()) > simd::detect_isa()) {
+            GTEST_SKIP() << "instruction set not supported by this CPU";
+        }
+    }
+};
+
+TEST(TestFftSimdLayout, ComplexIsViewedAsRawIntegers)
+{
+    EXPECT_TRUE(simd::k_is_q20_layout<Complex>);
+    const Complex value(from_raw(123456), from_raw(-654321));
+    int32_t       raw[2];
+    std::memcpy(raw, &value, sizeof(value));
+    EXPECT_EQ(raw[0], 123456);
+    EXPECT_EQ(raw[1], -654321);
+}
+
+TEST_P(TestFftSimd, IsaMatchesScalar)
+{
+    const auto [signal_size, isa] = GetParam();
+    // full scale input, so that the saturation paths are exercised too
+    auto scalar_signal = random_raw_signal(signal_size, simd::k_raw_max);
+    auto isa_signal    = scalar_signal;
+
+    simd::transform_q20(scalar_signal.data(), signal_size, Isa::scalar);
+    simd::transform_q20(isa_signal.data(), signal_size, isa);
+
+    EXPECT_EQ(isa_signal, scalar_signal);
+}
+
+TEST_P(TestFftSimd, SaturatesLikeElasticRange)
+{
+    const auto isa = std::get<1>(GetParam());
+    constexpr std::size_t count = 8;
+    // 1 + 0i twiddles, so that the butterflies are u + v and u - v
+    std::vector<int32_t> twiddles(2 * count, 0);
+    std::vector<int32_t> top(2 * count, simd::k_raw_max);
+    std::vector<int32_t> bottom(2 * count, simd::k_raw_max);
+    for (std::size_t j = 0; j < count; ++j) {
+        twiddles[2 * j] = 1 << simd::k_fraction_bits;
+        if (j % 2 == 1) {
+            top[2 * j]    = simd::k_raw_min;
+            bottom[2 * j] = simd::k_raw_min;
+        }
+        top[2 * j + 1] = simd::k_raw_min;
+    }
+
+    simd::butterflies(top.data(), bottom.data(), twiddles.data(), count, isa);
+
+    for (std::size_t j = 0; j < count; ++j) {
+        EXPECT_EQ(top[2 * j], j % 2 == 1 ? simd::k_raw_min : simd::k_raw_max) << "butterfly " << j;
+        EXPECT_EQ(bottom[2 * j], 0) << "butterfly " << j;
+        EXPECT_EQ(top[2 * j + 1], 0) << "butterfly " << j;
+        EXPECT_EQ(bottom[2 * j + 1], simd::k_raw_min) << "butterfly " << j;
+    }
+}
+
+TEST_P(TestFftSimd, MatchesCnlButterflies)
+{
+    const auto [signal_size, isa] = GetParam();
+    // keeps the growth of the transform within the range of the CNL type
+    const auto raw_signal = random_raw_signal(signal_size, (1 << simd::k_fraction_bits) * 1024 / signal_size);
+    auto       simd_signal = raw_signal;
+    std::vector<Complex> cnl_signal;
+    for (int i = 0; i < signal_size; ++i) {
+        cnl_signal.emplace_back(from_raw(raw_signal[2 * i]), from_raw(raw_signal[2 * i + 1]));
+    }
+
+    simd::transform_q20(simd_signal.data(), signal_size, isa);
+
+    // the same stages, with the same twiddle factors, through the CNL arithmetic
+    fft_utils::bit_reversal(cnl_signal);
+    for (int len = 2; len <= signal_size; len <<= 1) {
+        std::vector<int32_t> twiddles(len);
+        simd::fill_twiddles(twiddles.data(), len, 0, len / 2);
+        for (int i = 0; i < signal_size; i += len) {
+            for (int j = 0; j < len / 2; ++j) {
+                const Complex w(from_raw(twiddles[2 * j]), from_raw(twiddles[2 * j + 1]));
+                const auto    u = cnl_signal[i + j];
+                const auto    v = w * cnl_signal[i + j + len / 2];
+                cnl_signal[i + j]           = u + v;
+                cnl_signal[i + j + len / 2] = u - v;
+            }
+        }
+    }
+
+    for (int i = 0; i < signal_size; ++i) {
+        EXPECT_NEAR(simd_signal[2 * i], to_raw(cnl_signal[i].real()), k_lsb_tolerance) << "bin " << i;
+        EXPECT_NEAR(simd_signal[2 * i + 1], to_raw(cnl_signal[i].imag()), k_lsb_tolerance) << "bin " << i;
+    }
+}
+
+TEST_P(TestFftSimd, ComputeMatchesReferenceDft)
+{
+    const int signal_size = std::get<0>(GetParam());
+    const auto raw_signal = random_raw_signal(signal_size, (1 << simd::k_fraction_bits) * 1024 / signal_size);
+    std::vector<Complex>              signal;
+    std::vector<std::complex<double>> reference_signal;
+    for (int i = 0; i < signal_size; ++i) {
+        signal.emplace_back(from_raw(raw_signal[2 * i]), from_raw(raw_signal[2 * i + 1]));
+        reference_signal.emplace_back(static_cast<double>(signal.back().real()),
+                                      static_cast<double>(signal.back().imag()));
+    }
+    const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+
+    compute(signal);
+
+    for (int k = 0; k < signal_size; ++k) {
+        EXPECT_NEAR(static_cast<double>(signal[k].real()), reference_spectrum[k].real(), k_dft_tolerance) << "bin " << k;
+        EXPECT_NEAR(static_cast<double>(signal[k].imag()), reference_spectrum[k].imag(), k_dft_tolerance) << "bin " << k;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(TestFftSimdSizes,
+                        TestFftSimd,
+                        ::testing::Combine(::testing::Values(2, 4, 8, 16, 64, 512, 4096),
+                                           ::testing::Values(Isa::scalar, Isa::sse41, Isa::avx2)));
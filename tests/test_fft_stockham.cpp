@@ -0,0 +1,119 @@
+/**
+ * @file test_fft_stockham.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the Stockham autosort FFT and the tiled bit reversal permutation
+ */
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_tables.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "utils/include/testing_utils.hpp"
+
+using namespace fftemb;
+
+// error tolerances
+constexpr auto k_dft_tolerance    = 1e-2;
+constexpr auto k_double_tolerance = 1e-9;
+
+class TestStockham : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+    /**
+     * @brief Generates a test signal, kept within the range of Complex at every size
+     *
+     * @param size The signal size
+     * @return The signal
+     */
+    template <typename T>
+    static std::vector<T>
+    generate(std::size_t size)
+    {
+        const auto     amplitude = std::min(1.0, 512.0 / size);
+        std::vector<T> signal(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            signal[i] = T(amplitude * std::sin(2 * std::numbers::pi * 3 * i / size + 0.3),
+                          amplitude * 0.5 * std::cos(2 * std::numbers::pi * 5 * i / size));
+        }
+        return signal;
+    }
+};
+
+class TestBitReversalPermutation : public ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(TestStockham, StockhamMatchesReferenceDft)
+{
+    const auto                        size   = GetParam();
+    auto                              signal = generate<Complex>(size);
+    std::vector<Complex>              scratch(size);
+    std::vector<std::complex<double>> reference_signal(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        reference_signal[i] = test_utils::to_complex(signal[i]);
+    }
+    const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+
+    compute_stockham(signal, scratch);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(std::abs(test_utils::to_complex(signal[i]) - reference_spectrum[i]), 0, k_dft_tolerance)
+            << "bin " << i;
+    }
+}
+
+TEST_P(TestStockham, StockhamMatchesComputeInDoublePrecision)
+{
+    const auto                        size      = GetParam();
+    auto                              signal    = generate<std::complex<double>>(size);
+    auto                              reference = signal;
+    std::vector<std::complex<double>> scratch(size);
+
+    compute(reference);
+    compute_stockham(signal, scratch);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(std::abs(signal[i] - reference[i]), 0, k_double_tolerance * size) << "bin " << i;
+    }
+}
+
+TEST(TestStockhamSizes, SizesNotPowersOf2AreTransformedNatively)
+{
+    std::vector<std::complex<double>> signal(12, {1, 0});
+    std::vector<std::complex<double>> scratch(12);
+
+    compute_stockham(signal, scratch);
+
+    EXPECT_EQ(signal.size(), 12);
+    EXPECT_NEAR(signal[0].real(), 12, k_double_tolerance);
+    EXPECT_NEAR(std::abs(signal[1]), 0, k_double_tolerance);
+}
+
+TEST_P(TestBitReversalPermutation, PermutationMatchesReversedIndices)
+{
+    const auto           size   = GetParam();
+    const auto           levels = static_cast<std::size_t>(cnl::log2p1(size) - 1);
+    std::vector<int32_t> indices(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        indices[i] = static_cast<int32_t>(i);
+    }
+
+    fft_utils::bit_reversal(indices);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        ASSERT_EQ(indices[i], fft_utils::reverse_bits(i, levels)) << "index " << i;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Stockham, TestStockham, ::testing::Values(1, 2, 4, 8, 64, 512, 1024, 4096));
+
+// below and above the 2^8 elements of a tile, with even and odd numbers of middle bits
+INSTANTIATE_TEST_CASE_P(BitReversalPermutation,
+                        TestBitReversalPermutation,
+                        ::testing::Values(1, 2, 16, 128, 256, 512, 1024, 1 << 15, 1 << 16));
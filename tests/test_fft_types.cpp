@@ -0,0 +1,89 @@
+/**
+ * @file test_fft_types.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the numeric types and their traits
+ */
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "utils/include/testing_utils.hpp"
+
+using namespace fftemb;
+
+// buffer size
+constexpr std::size_t k_buffer_size = 1024;
+
+/**
+ * @brief Computes the spectrum of a two-tone signal with a numeric type, returning its SNR against double precision
+ *
+ * The amplitude is scaled so that the spectrum fits in the range of the type.
+ *
+ * @tparam T The complex number type
+ * @param amplitude The amplitude of the signal
+ * @return The signal-to-noise ratio of the spectrum, in dB
+ */
+template <typename T>
+double
+spectrum_snr(double amplitude)
+{
+    std::vector<T>                    test_signal(k_buffer_size);
+    std::vector<std::complex<double>> reference_signal(k_buffer_size);
+    for (std::size_t i = 0; i < k_buffer_size; ++i) {
+        test_signal[i] = T(amplitude * (0.6 * std::sin(2 * std::numbers::pi * 37 * i / k_buffer_size)
+                                        + 0.3 * std::cos(2 * std::numbers::pi * 101 * i / k_buffer_size)),
+                           0);
+        reference_signal[i] = {static_cast<double>(test_signal[i].real()), 0};
+    }
+    const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+
+    compute<T, std::vector>(test_signal);
+
+    std::vector<std::complex<double>> spectrum(k_buffer_size);
+    for (std::size_t i = 0; i < k_buffer_size; ++i) {
+        spectrum[i] = {static_cast<double>(test_signal[i].real()), static_cast<double>(test_signal[i].imag())};
+    }
+    return test_utils::signal_to_noise_ratio(spectrum, reference_spectrum);
+}
+
+TEST(TestNumericTypes, SpectrumSnrWithinBudget)
+{
+    EXPECT_GT(spectrum_snr<std::complex<double>>(1), 200);
+    EXPECT_GT(spectrum_snr<std::complex<float>>(1), 100);
+    EXPECT_GT(spectrum_snr<Complex>(1), 80);
+    EXPECT_GT(spectrum_snr<FastComplex>(1), 80);
+    EXPECT_GT(spectrum_snr<ComplexQ30>(1.0 / k_buffer_size), 80);
+    EXPECT_GT(spectrum_snr<ComplexQ14>(1.0 / k_buffer_size), 10);
+}
+
+TEST(TestNumericTypes, NormalizeWithEachType)
+{
+    std::vector<std::complex<double>> double_signal{{0.25, 0}, {-0.5, 0}, {0.3, 0.4}};
+    std::vector<std::complex<float>>  float_signal{{0.25f, 0}, {-0.5f, 0}, {0.3f, 0.4f}};
+    std::vector<ComplexQ30>           q30_signal{{0.25, 0}, {-0.5, 0}, {0.3, 0.4}};
+    std::vector<FastComplex>          fast_signal{{0.25, 0}, {-0.5, 0}, {0.3, 0.4}};
+
+    EXPECT_NEAR(static_cast<double>(fft_utils::normalize(double_signal)), 0.5, 1e-12);
+    EXPECT_NEAR(static_cast<double>(fft_utils::normalize(float_signal)), 0.5, 1e-6);
+    EXPECT_NEAR(static_cast<double>(fft_utils::normalize(q30_signal)), 0.5, 1e-6);
+    EXPECT_NEAR(static_cast<double>(fft_utils::normalize(fast_signal)), 0.5, 1e-5);
+
+    EXPECT_NEAR(double_signal[0].real(), 0.5, 1e-12);
+    EXPECT_NEAR(float_signal[1].real(), -1, 1e-6);
+    EXPECT_NEAR(static_cast<double>(q30_signal[2].imag()), 0.8, 1e-6);
+    EXPECT_NEAR(static_cast<double>(fast_signal[2].real()), 0.6, 1e-5);
+}
+
+TEST(TestNumericTypes, TraitsMatchTheType)
+{
+    EXPECT_TRUE(numeric_traits<safe_rounding_elastic_integer>::is_fixed_point);
+    EXPECT_TRUE(numeric_traits<q1_14>::is_fixed_point);
+    EXPECT_FALSE(numeric_traits<float>::is_fixed_point);
+    EXPECT_DOUBLE_EQ(numeric_traits<double>::sqrt(2.25), 1.5);
+    EXPECT_NEAR(static_cast<double>(numeric_traits<q1_30>::sqrt(q1_30{0.25})), 0.5, 1e-6);
+}
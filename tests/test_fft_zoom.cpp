@@ -0,0 +1,148 @@
+/**
+ * @file test_fft_zoom.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the ZoomFft class
+ */
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <numbers>
+#include <vector>
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "fft_zoom.hpp"
+#include "gtest/gtest.h"
+#include "window.hpp"
+
+using namespace fftemb;
+
+// transform size and decimation factor
+constexpr std::size_t k_zoom_size  = 256;
+constexpr std::size_t k_decimation = 16;
+constexpr std::size_t k_block_size = k_zoom_size * k_decimation;
+
+// the half width of the central bins checked, where the decimation filters are flat
+constexpr int k_band = k_zoom_size / 4;
+
+// sampling period and the bin of the block at the center of the band
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::microseconds(100);
+constexpr double                   k_resolution      = 1e4 / k_block_size;
+constexpr double                   k_center          = 1000 * k_resolution;
+
+// error tolerances, relative to the amplitude of the sinusoids
+constexpr auto k_amplitude_tolerance = 1e-3;
+constexpr auto k_leakage_tolerance   = 1e-3;
+constexpr auto k_block_tolerance     = 2e-3;
+
+/**
+ * @brief Generates a sum of real sinusoids
+ *
+ * @param frequencies The frequencies of the sinusoids, in Hz
+ * @param amplitude The amplitude of each sinusoid
+ * @return The block of samples
+ */
+template <typename T = Complex>
+std::vector<T>
+generate(const std::vector<double>& frequencies, double amplitude)
+{
+    std::vector<T> signal(k_block_size);
+    for (std::size_t i = 0; i < k_block_size; ++i) {
+        double sample = 0;
+        for (const auto frequency : frequencies) {
+            sample += amplitude * std::cos(2 * std::numbers::pi * frequency * i * 1e-4 + 0.3);
+        }
+        signal[i] = T(sample, 0);
+    }
+    return signal;
+}
+
+/**
+ * @brief Get the amplitude read on a bin, 2|X| / M
+ *
+ * @param bin The bin
+ * @return The amplitude
+ */
+template <typename T>
+double
+amplitude(const T& bin)
+{
+    return 2 * std::hypot(static_cast<double>(bin.real()), static_cast<double>(bin.imag())) / k_zoom_size;
+}
+
+class TestZoomFFT : public ::testing::TestWithParam<int>
+{
+};
+
+TEST_P(TestZoomFFT, ToneLandsOnItsBin)
+{
+    const auto                         offset = GetParam();
+    const auto                         bin    = (offset + k_zoom_size) % k_zoom_size;
+    ZoomFft<k_zoom_size, k_decimation> zoom(k_center, k_sampling_period);
+    std::vector<Complex>               spectrum(k_zoom_size);
+
+    zoom.execute(generate({k_center + offset * k_resolution}, 0.5), spectrum);
+
+    EXPECT_NEAR(zoom.frequency(bin), k_center + offset * k_resolution, 1e-9);
+    EXPECT_NEAR(amplitude(spectrum[bin]), 0.5, 0.5 * k_amplitude_tolerance);
+    // a Hann-windowed sinusoid on a bin only leaks onto its two neighbours
+    for (int j = -k_band; j < k_band; ++j) {
+        if (std::abs(j - offset) > 1) {
+            EXPECT_LT(amplitude(spectrum[(j + k_zoom_size) % k_zoom_size]), 0.5 * k_leakage_tolerance) << "bin " << j;
+        }
+    }
+}
+
+TEST_P(TestZoomFFT, MatchesAWholeBlockTransform)
+{
+    const auto offset = GetParam();
+    const auto frequencies
+        = std::vector<double>{k_center + (offset + 0.37) * k_resolution, k_center - 7.5 * k_resolution};
+    ZoomFft<k_zoom_size, k_decimation, std::complex<double>> zoom(k_center, k_sampling_period);
+    std::vector<std::complex<double>>                        spectrum(k_zoom_size);
+    auto                                                     block = generate<std::complex<double>>(frequencies, 0.25);
+
+    zoom.execute(block, spectrum);
+    const auto& window = window_table<double>(WindowType::hann, k_block_size);
+    for (std::size_t i = 0; i < k_block_size; ++i) {
+        block[i] *= window[i];
+    }
+    compute(block);
+
+    for (int j = -k_band; j < k_band; ++j) {
+        const auto zoomed    = amplitude(spectrum[(j + k_zoom_size) % k_zoom_size]);
+        const auto reference = amplitude(block[1000 + j]) / k_decimation;
+        EXPECT_NEAR(zoomed, reference, 0.25 * k_block_tolerance) << "bin " << j;
+    }
+}
+
+TEST_P(TestZoomFFT, RejectsTonesOutsideTheBand)
+{
+    const auto offset = std::abs(GetParam());
+    // beyond the band on both sides, where they would fold onto the central bins
+    const auto frequencies = std::vector<double>{k_center + (k_zoom_size + offset) * k_resolution,
+                                                 k_center - (3 * k_zoom_size / 4.0 + offset) * k_resolution};
+    ZoomFft<k_zoom_size, k_decimation> zoom(k_center, k_sampling_period);
+    std::vector<Complex>               spectrum(k_zoom_size);
+
+    zoom.execute(generate(frequencies, 0.5), spectrum);
+
+    for (int j = -k_band; j < k_band; ++j) {
+        EXPECT_LT(amplitude(spectrum[(j + k_zoom_size) % k_zoom_size]), 0.5 * k_leakage_tolerance) << "bin " << j;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(ZoomFftTests, TestZoomFFT, ::testing::Values(0, 5, -20, 60));
+
+TEST(ZoomFftBins, FrequenciesWrapBelowTheCenter)
+{
+    const ZoomFft<k_zoom_size, k_decimation> zoom(k_center, k_sampling_period);
+
+    EXPECT_EQ(zoom.size(), k_block_size);
+    EXPECT_DOUBLE_EQ(zoom.resolution(), k_resolution);
+    EXPECT_DOUBLE_EQ(zoom.frequency(0), k_center);
+    EXPECT_DOUBLE_EQ(zoom.frequency(k_zoom_size / 2 - 1), k_center + (k_zoom_size / 2 - 1) * k_resolution);
+    EXPECT_DOUBLE_EQ(zoom.frequency(k_zoom_size / 2), k_center - k_zoom_size / 2 * k_resolution);
+    EXPECT_DOUBLE_EQ(zoom.frequency(k_zoom_size - 1), k_center - k_resolution);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file test_ingest.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the ingest of raw integer samples
+ */
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <vector>
+#include "fft_simd.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "ingest.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+
+// error tolerances, in Q11.20 steps
+constexpr auto k_lsb          = 1.0 / (1 << simd::k_fraction_bits);
+constexpr auto k_ingest_error = 0.5 * k_lsb;
+constexpr auto k_window_error = 1.5 * k_lsb;
+
+/**
+ * @brief Generates ADC-like samples: a sinusoid on top of a DC offset, with a few full-scale values
+ *
+ * @param size The number of samples
+ * @param amplitude The amplitude of the sinusoid
+ * @param offset The DC offset
+ * @return The samples
+ */
+template <typename Sample>
+std::vector<Sample>
+make_samples(std::size_t size, double amplitude, double offset)
+{
+    std::vector<Sample> samples(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto phase = 2 * std::numbers::pi * 5.5 * i / size;
+        samples[i]       = static_cast<Sample>(std::lround(offset + amplitude * std::sin(phase)));
+    }
+    samples[0] = std::numeric_limits<Sample>::min();
+    samples[1] = std::numeric_limits<Sample>::max();
+    return samples;
+}
+
+class TestIngest : public ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(TestIngest, Int16FullScaleMapsToOne)
+{
+    const auto           samples = make_samples<int16_t>(GetParam(), 12000, 300);
+    std::vector<Complex> signal(samples.size());
+
+    fft_utils::ingest(std::span(samples), signal);
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_NEAR(static_cast<double>(signal[i].real()), samples[i] / 32768.0, k_ingest_error);
+        EXPECT_EQ(static_cast<double>(signal[i].imag()), 0);
+    }
+}
+
+TEST_P(TestIngest, Int32IsRoundedToQ20)
+{
+    const auto           samples = make_samples<int32_t>(GetParam(), 1.5e9, -2e7);
+    std::vector<Complex> signal(samples.size());
+
+    fft_utils::ingest(std::span(samples), signal);
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_NEAR(static_cast<double>(signal[i].real()), std::ldexp(samples[i], -31), k_ingest_error);
+    }
+}
+
+TEST_P(TestIngest, DcOffsetIsRemoved)
+{
+    const auto           samples = make_samples<int16_t>(GetParam(), 8000, 5000);
+    std::vector<Complex> signal(samples.size());
+    double               mean = 0;
+    for (const auto sample : samples) {
+        mean += sample;
+    }
+    mean /= samples.size();
+
+    fft_utils::ingest(std::span(samples), signal, fft_utils::k_full_scale_shift<int16_t>, true);
+
+    double sum = 0;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_NEAR(static_cast<double>(signal[i].real()), (samples[i] - mean) / 32768.0, 2 * k_ingest_error);
+        sum += static_cast<double>(signal[i].real());
+    }
+    EXPECT_NEAR(sum / samples.size(), 0, k_lsb);
+}
+
+TEST_P(TestIngest, WindowMatchesApplyWindow)
+{
+    const auto           samples = make_samples<int16_t>(GetParam(), 20000, -1000);
+    std::vector<Complex> fused(samples.size());
+    std::vector<Complex> separate(samples.size());
+
+    fft_utils::ingest(std::span(samples), fused, WindowType::blackman_harris, 15, true);
+    fft_utils::ingest(std::span(samples), separate, 15, true);
+    fft_utils::apply_window(separate, WindowType::blackman_harris);
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_NEAR(static_cast<double>(fused[i].real()), static_cast<double>(separate[i].real()), k_window_error);
+    }
+}
+
+TEST_P(TestIngest, FloatingPointMatchesTheScaledSamples)
+{
+    const auto                        samples = make_samples<int16_t>(GetParam(), 12000, 300);
+    std::vector<std::complex<double>> signal(samples.size());
+
+    fft_utils::ingest(std::span(samples), signal, WindowType::hann, 12);
+
+    const auto& window = window_table<double>(WindowType::hann, samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_DOUBLE_EQ(signal[i].real(), std::ldexp(samples[i], -12) * window[i]);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(IngestTests, TestIngest, ::testing::Values(16, 256, 4096));
+
+TEST(IngestScaling, SmallShiftsScaleUpAndSaturate)
+{
+    const std::vector<int16_t> samples{1, -3, 2047, -2048, 4096, -32768};
+    std::vector<Complex>       signal(samples.size());
+
+    // integer samples read as Q15.0: the values beyond the range of Q11.20 saturate
+    fft_utils::ingest(std::span(samples), signal, 0);
+
+    EXPECT_EQ(static_cast<double>(signal[0].real()), 1);
+    EXPECT_EQ(static_cast<double>(signal[1].real()), -3);
+    EXPECT_EQ(static_cast<double>(signal[2].real()), 2047);
+    EXPECT_EQ(static_cast<double>(signal[3].real()), -2048 + k_lsb);
+    EXPECT_EQ(static_cast<double>(signal[4].real()), 2048 - k_lsb);
+    EXPECT_EQ(static_cast<double>(signal[5].real()), -2048 + k_lsb);
+}
+
+TEST(IngestScaling, RoundsHalfAwayFromZero)
+{
+    // with 22 fractional bits, the samples lose 2 bits: 2 and 6 are halves of Q11.20 steps
+    const std::vector<int32_t> samples{2, -2, 6, -6, 1, -1, 3, -3};
+    std::vector<Complex>       signal(samples.size());
+
+    fft_utils::ingest(std::span(samples), signal, 22);
+
+    const std::vector<double> expected{1, -1, 2, -2, 0, 0, 1, -1};
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_EQ(static_cast<double>(signal[i].real()), expected[i] * k_lsb) << "sample " << samples[i];
+    }
+}
@@ -0,0 +1,209 @@
+/**
+ * @file test_instrumentation.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the instrumentation of the hot paths
+ */
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "instrumentation.hpp"
+
+using namespace fftemb;
+
+class TestInstrumentation : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+    void
+    SetUp() override
+    {
+        instrumentation::reset();
+    }
+};
+
+TEST_P(TestInstrumentation, ComputeRecordsEveryStage)
+{
+    const auto           size = GetParam();
+    std::vector<Complex> signal(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        signal[i] = Complex(std::cos(2 * std::numbers::pi * 3 * i / size), 0);
+    }
+
+    compute(signal);
+    const auto counters = instrumentation::snapshot();
+
+    const auto stages = static_cast<std::size_t>(std::log2(size));
+    if constexpr (instrumentation::k_enabled) {
+        EXPECT_EQ(counters.probes[static_cast<std::size_t>(instrumentation::Probe::compute)].calls, 1u);
+        EXPECT_EQ(counters.probes[static_cast<std::size_t>(instrumentation::Probe::bit_reversal)].calls, 1u);
+        // the SIMD engine fuses the first two stages
+        for (std::size_t stage = 1; stage < stages; ++stage) {
+            EXPECT_EQ(counters.stages[stage].timing.calls, 1u) << "stage " << stage;
+            EXPECT_EQ(counters.stages[stage].saturations, 0u) << "stage " << stage;
+        }
+        // a unit cosine grows to N/2 at its bin, out of the 2^11 of Q11.20
+        EXPECT_NEAR(counters.stages[stages - 1].headroom_bits(), 12 - std::log2(size), 1e-3);
+    }
+    else {
+        EXPECT_EQ(counters.probes[static_cast<std::size_t>(instrumentation::Probe::compute)].calls, 0u);
+        EXPECT_EQ(counters.stages[stages - 1].timing.calls, 0u);
+    }
+}
+
+TEST_P(TestInstrumentation, OtherKernelsRecordTheirLastStage)
+{
+    const auto size   = GetParam();
+    const auto stages = static_cast<std::size_t>(std::log2(size));
+    for (const auto kernel : {FftKernel::radix4, FftKernel::split_radix}) {
+        instrumentation::reset();
+        std::vector<Complex> signal(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            signal[i] = Complex(std::cos(2 * std::numbers::pi * 3 * i / size), 0);
+        }
+
+        compute(signal, kernel);
+        const auto  counters = instrumentation::snapshot();
+        const auto& last     = counters.stages[stages - 1];
+
+        if constexpr (instrumentation::k_enabled) {
+            EXPECT_EQ(last.timing.calls, 1u);
+            EXPECT_EQ(last.saturations, 0u);
+            EXPECT_NEAR(last.headroom_bits(), 12 - std::log2(size), 1e-3);
+        }
+        else {
+            EXPECT_EQ(last.timing.calls, 0u);
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(InstrumentationTests, TestInstrumentation, ::testing::Values(16, 256, 1024));
+
+TEST(InstrumentationCounters, ComputeCountsTheSaturationsOfTheLastStage)
+{
+    instrumentation::reset();
+    // a unit cosine of 4096 points grows to 2^11 at its bins, just out of the range of Q11.20
+    constexpr std::size_t k_size = 4096;
+    std::vector<Complex>  signal(k_size);
+    for (std::size_t i = 0; i < k_size; ++i) {
+        signal[i] = Complex(std::cos(2 * std::numbers::pi * 3 * i / k_size), 0);
+    }
+
+    compute(signal);
+    const auto counters = instrumentation::snapshot();
+
+    if constexpr (instrumentation::k_enabled) {
+        EXPECT_EQ(counters.stages[10].saturations, 0u);
+        EXPECT_EQ(counters.stages[11].saturations, 2u);
+        EXPECT_NEAR(counters.stages[11].headroom_bits(), 0, 1e-6);
+    }
+    else {
+        EXPECT_EQ(counters.stages[11].saturations, 0u);
+    }
+}
+
+TEST(InstrumentationCounters, RecordStageCountsRailsAndPeak)
+{
+    instrumentation::reset();
+    constexpr auto               k_max = std::numeric_limits<int32_t>::max();
+    const std::array<int32_t, 6> raw{0, k_max / 4, -k_max / 2, k_max, std::numeric_limits<int32_t>::min(), 7};
+
+    instrumentation::record_stage(3, instrumentation::now(), raw.data(), raw.size());
+    instrumentation::record_stage(3, instrumentation::now(), raw.data(), 3);
+    const auto stage = instrumentation::snapshot().stages[3];
+
+    EXPECT_EQ(stage.timing.calls, 2u);
+    EXPECT_EQ(stage.saturations, 2u);
+    EXPECT_NEAR(stage.headroom_bits(), 0, 1e-9);
+    EXPECT_TRUE(std::isinf(instrumentation::snapshot().stages[4].headroom_bits()));
+}
+
+TEST(InstrumentationCounters, RecordStageOfComplexUsesTheRangeOfTheComponents)
+{
+    instrumentation::reset();
+    const std::array<std::complex<float>, 2> data{std::complex<float>(1, -0.5f),
+                                                  std::complex<float>(0, std::numeric_limits<float>::max())};
+
+    instrumentation::record_stage(0, instrumentation::now(), data.data(), 1);
+    EXPECT_EQ(instrumentation::snapshot().stages[0].saturations, 0u);
+    EXPECT_NEAR(instrumentation::snapshot().stages[0].headroom_bits(), 128, 1e-3);
+
+    instrumentation::record_stage(0, instrumentation::now(), data.data(), data.size());
+    EXPECT_EQ(instrumentation::snapshot().stages[0].saturations, 1u);
+}
+
+TEST(InstrumentationCounters, ScopedProbeTimesItsScope)
+{
+    instrumentation::reset();
+    {
+        const instrumentation::ScopedProbe probe(instrumentation::Probe::window);
+    }
+    {
+        const instrumentation::ScopedProbe probe(instrumentation::Probe::window);
+    }
+    const auto timing = instrumentation::snapshot().probes[static_cast<std::size_t>(instrumentation::Probe::window)];
+
+    EXPECT_EQ(timing.calls, 2u);
+    EXPECT_LE(timing.max_nanoseconds, timing.nanoseconds);
+}
+
+TEST(InstrumentationCounters, DumpsListTheProbesAndTheRecordedStages)
+{
+    instrumentation::reset();
+    const std::array<int32_t, 2> raw{1 << 20, -(1 << 10)};
+    instrumentation::record_stage(5, instrumentation::now(), raw.data(), raw.size());
+    const auto counters = instrumentation::snapshot();
+
+    const auto prometheus = instrumentation::to_prometheus(counters);
+    EXPECT_NE(prometheus.find("fftemb_calls_total{probe=\"compute\"} 0\n"), std::string::npos);
+    EXPECT_NE(prometheus.find("fftemb_calls_total{probe=\"stage\",stage=\"5\"} 1\n"), std::string::npos);
+    EXPECT_NE(prometheus.find("fftemb_stage_saturations_total{stage=\"5\"} 0\n"), std::string::npos);
+    EXPECT_NE(prometheus.find("fftemb_stage_headroom_bits{stage=\"5\"} 11"), std::string::npos);
+    EXPECT_EQ(prometheus.find("stage=\"4\""), std::string::npos);
+
+    const auto json = instrumentation::to_json(counters);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find("\"normalize\":{\"calls\":0,"), std::string::npos);
+    EXPECT_NE(json.find("\"stages\":[{\"stage\":5,\"calls\":1,"), std::string::npos);
+    EXPECT_NE(json.find("\"saturations\":0,\"headroom_bits\":11}]"), std::string::npos);
+}
+
+TEST(InstrumentationCounters, PrometheusFamiliesAreContiguous)
+{
+    instrumentation::reset();
+    const std::array<int32_t, 2> raw{1 << 20, -(1 << 10)};
+    const std::array<int32_t, 2> zeros{0, 0};
+    instrumentation::record_stage(3, instrumentation::now(), zeros.data(), zeros.size());
+    instrumentation::record_stage(5, instrumentation::now(), raw.data(), raw.size());
+
+    const auto prometheus = instrumentation::to_prometheus(instrumentation::snapshot());
+    EXPECT_NE(prometheus.find("fftemb_stage_saturations_total{stage=\"3\"} 0\n"), std::string::npos);
+    EXPECT_EQ(prometheus.find("fftemb_stage_headroom_bits{stage=\"3\"}"), std::string::npos);
+
+    // every sample belongs to the family of the last TYPE line, and no family comes back
+    std::istringstream    lines(prometheus);
+    std::set<std::string> families;
+    std::string           family;
+    std::string           line;
+    while (std::getline(lines, line)) {
+        if (line.starts_with("# TYPE ")) {
+            family = line.substr(7, line.find(' ', 7) - 7);
+            EXPECT_TRUE(families.insert(family).second) << family;
+        }
+        else {
+            EXPECT_EQ(line.substr(0, line.find('{')), family) << line;
+        }
+        EXPECT_EQ(line.find("inf"), std::string::npos) << line;
+    }
+    EXPECT_EQ(families.size(), 6u);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file test_peak_detector.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the spectral peak detector
+ */
+
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "peak_detector.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+
+// buffer size
+constexpr std::size_t k_buffer_size = 256;
+
+// sampling period
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::milliseconds(1);
+
+// error tolerances
+constexpr auto k_parabolic_bin_tolerance = 0.02;
+constexpr auto k_jacobsen_bin_tolerance  = 1e-3;
+constexpr auto k_amplitude_tolerance     = 0.04;
+
+class TestPeakDetector : public ::testing::TestWithParam<double>
+{
+protected:
+    /**
+     * @brief Computes the spectrum of a sinusoid at a fractional bin
+     *
+     * @param bin The fractional bin of the sinusoid
+     * @param amplitude The amplitude of the sinusoid
+     * @param window Whether to apply the Hann window
+     * @return The spectrum
+     */
+    static std::vector<Complex>
+    spectrum(double bin, double amplitude, bool window)
+    {
+        std::vector<Complex> signal(k_buffer_size);
+        for (std::size_t i = 0; i < k_buffer_size; ++i) {
+            signal[i] = Complex(amplitude * std::cos(2 * std::numbers::pi * bin * i / k_buffer_size + 0.4), 0);
+        }
+        if (window) {
+            fft_utils::apply_window(signal, WindowType::hann);
+        }
+        compute(signal);
+        return signal;
+    }
+};
+
+TEST_P(TestPeakDetector, ParabolicInterpolationOfWindowedSpectrum)
+{
+    const auto bin   = GetParam();
+    const auto peaks = find_peaks<1>(spectrum(bin, 2, true), k_sampling_period, PeakInterpolation::parabolic);
+
+    ASSERT_EQ(peaks.size(), 1);
+    EXPECT_NEAR(peaks[0].bin, bin, k_parabolic_bin_tolerance);
+    EXPECT_NEAR(peaks[0].frequency, bin * 1000 / k_buffer_size, k_parabolic_bin_tolerance * 1000 / k_buffer_size);
+    EXPECT_NEAR(peaks[0].amplitude, 2, 2 * k_amplitude_tolerance);
+}
+
+TEST_P(TestPeakDetector, JacobsenInterpolationOfUnwindowedSpectrum)
+{
+    const auto bin   = GetParam();
+    const auto peaks = find_peaks<1>(spectrum(bin, 2, false), k_sampling_period, PeakInterpolation::jacobsen);
+
+    ASSERT_EQ(peaks.size(), 1);
+    EXPECT_NEAR(peaks[0].bin, bin, k_jacobsen_bin_tolerance);
+    EXPECT_NEAR(peaks[0].amplitude, 2, 2 * k_amplitude_tolerance);
+}
+
+TEST(TestPeakDetectorSelection, LargestPeaksFirst)
+{
+    std::vector<Complex> signal(k_buffer_size);
+    const std::vector<std::pair<double, double>> tones{{0.5, 20}, {2, 45}, {1, 70}, {0.25, 100}};
+    for (std::size_t i = 0; i < k_buffer_size; ++i) {
+        double value = 0;
+        for (const auto& [amplitude, bin] : tones) {
+            value += amplitude * std::sin(2 * std::numbers::pi * bin * i / k_buffer_size);
+        }
+        signal[i] = Complex(value, 0);
+    }
+    compute(signal);
+
+    const auto peaks = find_peaks<3>(signal, k_sampling_period, PeakInterpolation::none);
+
+    ASSERT_EQ(peaks.size(), 3);
+    EXPECT_EQ(peaks[0].bin, 45);
+    EXPECT_EQ(peaks[1].bin, 70);
+    EXPECT_EQ(peaks[2].bin, 20);
+    EXPECT_NEAR(peaks[0].amplitude, 2, 1e-3);
+}
+
+TEST(TestPeakDetectorSelection, FlatSpectrumHasNoPeaks)
+{
+    std::vector<Complex> spectrum(k_buffer_size, Complex(1, 0));
+
+    EXPECT_TRUE((find_peaks<4>(spectrum, k_sampling_period).empty()));
+}
+
+INSTANTIATE_TEST_CASE_P(FractionalBins, TestPeakDetector, ::testing::Values(30, 30.1, 30.25, 30.5, 41.7, 60.93));
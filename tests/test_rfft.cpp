@@ -0,0 +1,122 @@
+/**
+ * @file test_rfft.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the real-input FFT
+ */
+
+#include <chrono>
+#include <complex>
+#include <numbers>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "rfft.hpp"
+#include "utils/include/signal_generator.hpp"
+#include "utils/include/testing_utils.hpp"
+
+using SignalParameters = std::vector<std::pair<double, double>>;
+using namespace fftemb;
+using Real = safe_rounding_elastic_integer;
+
+// error tolerances
+constexpr auto k_bin_tolerance    = 1e-2;
+constexpr auto k_sample_tolerance = 1e-4;
+
+// signal generator
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::milliseconds(1);
+
+class TestRfft : public ::testing::TestWithParam<std::tuple<int, FftKernel>>
+{
+protected:
+    /**
+     * @brief Generates a normalized real signal, along with its complex copy
+     *
+     * @param signal_size The number of samples
+     * @param[out] real_signal The real signal
+     * @param[out] complex_signal The complex signal
+     */
+    static void
+    generate(int signal_size, std::vector<Real>& real_signal, std::vector<Complex>& complex_signal)
+    {
+        const auto duration = k_sampling_period * (signal_size - 1);
+        complex_signal.resize(signal_size);
+        SignalGenerator<Complex, std::vector>(duration, k_sampling_period)
+            .generate_sine_wave(complex_signal, SignalParameters{{5, 60}, {3, 125}, {1, 310}});
+        fft_utils::normalize(complex_signal);
+        real_signal.clear();
+        for (const auto& sample : complex_signal) {
+            real_signal.push_back(sample.real());
+        }
+    }
+};
+
+TEST_P(TestRfft, RfftMatchesReferenceDft)
+{
+    const int            signal_size = std::get<0>(GetParam());
+    std::vector<Real>    real_signal;
+    std::vector<Complex> complex_signal;
+    std::vector<Complex> spectrum;
+    generate(signal_size, real_signal, complex_signal);
+    std::vector<std::complex<double>> reference_signal;
+    for (const auto& sample : real_signal) {
+        reference_signal.emplace_back(static_cast<double>(sample), 0);
+    }
+    const auto reference_spectrum = test_utils::reference_dft(reference_signal);
+
+    rfft(real_signal, spectrum, std::get<1>(GetParam()));
+
+    ASSERT_EQ(spectrum.size(), signal_size / 2 + 1);
+    for (int k = 0; k <= signal_size / 2; ++k) {
+        EXPECT_NEAR(static_cast<double>(spectrum[k].real()), reference_spectrum[k].real(), k_bin_tolerance)
+            << "bin " << k;
+        EXPECT_NEAR(static_cast<double>(spectrum[k].imag()), reference_spectrum[k].imag(), k_bin_tolerance)
+            << "bin " << k;
+    }
+}
+
+TEST_P(TestRfft, InverseRecoversSignal)
+{
+    const auto [signal_size, kernel] = GetParam();
+    std::vector<Real>    real_signal;
+    std::vector<Complex> complex_signal;
+    std::vector<Complex> spectrum;
+    generate(signal_size, real_signal, complex_signal);
+    std::vector<Real> recovered_signal(signal_size);
+
+    rfft(real_signal, spectrum, kernel);
+    irfft(spectrum, recovered_signal);
+
+    for (int i = 0; i < signal_size; ++i) {
+        EXPECT_NEAR(static_cast<double>(recovered_signal[i]), static_cast<double>(real_signal[i]), k_sample_tolerance)
+            << "sample " << i;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(TestRfftSizes,
+                        TestRfft,
+                        ::testing::Combine(::testing::Values(2, 4, 8, 64, 512, 2048),
+                                           ::testing::Values(FftKernel::radix4, FftKernel::split_radix)));
+
+TEST(RfftRoundTrip, ImpulseDoesNotOverflowTheInverse)
+{
+    constexpr std::size_t signal_size = 1024;
+    std::vector<Real>     impulse(signal_size, Real{0});
+    std::vector<Real>     recovered_signal(signal_size);
+    std::vector<Complex>  spectrum;
+    impulse[0] = Real{8};
+
+    // a flat spectrum of 8, whose unscaled inverse would peak at 8 N / 2 before the 1/N scaling
+    rfft(impulse, spectrum);
+    for (const auto& bin : spectrum) {
+        EXPECT_NEAR(static_cast<double>(bin.real()), 8, k_bin_tolerance);
+        EXPECT_NEAR(static_cast<double>(bin.imag()), 0, k_bin_tolerance);
+    }
+    irfft(spectrum, recovered_signal);
+
+    for (std::size_t i = 0; i < signal_size; ++i) {
+        EXPECT_NEAR(static_cast<double>(recovered_signal[i]), static_cast<double>(impulse[i]), k_sample_tolerance)
+            << "sample " << i;
+    }
+}
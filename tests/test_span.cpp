@@ -0,0 +1,150 @@
+/**
+ * @file test_span.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the overloads taking std::span, on memory owned by the caller
+ */
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "peak_detector.hpp"
+#include "utils/include/testing_utils.hpp"
+
+using namespace fftemb;
+
+// sampling period
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::milliseconds(1);
+
+class TestSpan : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+    /**
+     * @brief Generates a sine wave
+     *
+     * @param size The signal size
+     * @return The signal
+     */
+    static std::vector<Complex>
+    generate(std::size_t size)
+    {
+        std::vector<Complex> signal(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            signal[i] = Complex(std::sin(2 * std::numbers::pi * 5 * i / size + 0.2), 0);
+        }
+        return signal;
+    }
+};
+
+TEST_P(TestSpan, ComputeMatchesContainer)
+{
+    auto reference = generate(GetParam());
+    auto buffer    = reference;
+
+    compute(reference);
+    compute(std::span<Complex>(buffer));
+
+    EXPECT_EQ(buffer, reference);
+}
+
+TEST_P(TestSpan, ComputeWithKernelsMatchesContainer)
+{
+    for (const auto kernel : {FftKernel::radix4, FftKernel::split_radix}) {
+        auto reference = generate(GetParam());
+        auto buffer    = reference;
+
+        compute(reference, kernel);
+        compute(std::span<Complex>(buffer), kernel);
+
+        EXPECT_EQ(buffer, reference);
+    }
+}
+
+TEST_P(TestSpan, DspUtilsMatchContainer)
+{
+    auto reference = generate(GetParam());
+    auto buffer    = reference;
+
+    fft_utils::apply_hann_window(reference);
+    fft_utils::apply_hann_window(std::span<Complex>(buffer));
+    EXPECT_EQ(buffer, reference);
+
+    fft_utils::bit_reversal(reference);
+    fft_utils::bit_reversal(std::span<Complex>(buffer));
+    EXPECT_EQ(buffer, reference);
+
+    EXPECT_EQ(fft_utils::normalize(std::span<Complex>(buffer)), fft_utils::normalize(reference));
+    EXPECT_EQ(buffer, reference);
+}
+
+TEST_P(TestSpan, FindPeaksMatchesContainer)
+{
+    auto spectrum = generate(GetParam());
+    fft_utils::apply_hann_window(spectrum);
+    compute(spectrum);
+
+    const auto expected = find_peaks<2>(spectrum, k_sampling_period);
+    const auto peaks    = find_peaks<2>(std::span<const Complex>(spectrum), k_sampling_period);
+
+    ASSERT_EQ(peaks.size(), expected.size());
+    for (std::size_t i = 0; i < peaks.size(); ++i) {
+        EXPECT_EQ(peaks[i].bin, expected[i].bin);
+        EXPECT_EQ(peaks[i].amplitude, expected[i].amplitude);
+    }
+}
+
+TEST(TestSpanStaticExtent, ArrayIsTransformedInPlace)
+{
+    std::array<std::complex<double>, 8> buffer{};
+    buffer[0] = 1;
+
+    compute(std::span(buffer));
+
+    for (const auto& bin : buffer) {
+        EXPECT_NEAR(std::abs(bin - std::complex<double>(1, 0)), 0, 1e-12);
+    }
+}
+
+TEST(TestSpanNativeSize, SizeNotPowerOf2MatchesContainer)
+{
+    std::vector<std::complex<double>> reference(12);
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        reference[i] = {std::cos(0.7 * i), 0};
+    }
+    auto buffer = reference;
+
+    compute(reference);
+    compute(std::span(buffer));
+
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+        EXPECT_NEAR(std::abs(buffer[i] - reference[i]), 0, 1e-12);
+    }
+}
+
+TEST(TestInterleavedView, RawIntegersAreTransformedInPlace)
+{
+    // a Q11.20 DMA buffer holding an impulse of amplitude 0.5, 2 integers per sample
+    std::array<int32_t, 2 * 64> raw{};
+    raw[0] = 1 << 19;
+
+    auto view = interleaved_view(std::span(raw));
+    ASSERT_EQ(view.size(), 64);
+    ASSERT_EQ(static_cast<const void*>(view.data()), static_cast<const void*>(raw.data()));
+    compute(view);
+
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        EXPECT_EQ(raw[2 * i], 1 << 19) << "bin " << i;
+        EXPECT_EQ(raw[2 * i + 1], 0) << "bin " << i;
+        EXPECT_NEAR(std::abs(test_utils::to_complex(view[i]) - std::complex<double>(0.5, 0)), 0, 1e-9);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Span, TestSpan, ::testing::Values(16, 256, 1024));
@@ -0,0 +1,197 @@
+/**
+ * @file test_spectrogram.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the batch spectrogram of raw PCM recordings
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <string>
+#include <vector>
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "mapped_file.hpp"
+#include "spectrogram.hpp"
+#include "thread_pool.hpp"
+
+using namespace fftemb;
+
+// error tolerances, relative to the frame size
+constexpr auto k_magnitude_tolerance = 1e-4;
+
+/**
+ * @brief Generates interleaved samples of one sinusoid per channel, in periods per frame
+ *
+ * @param samples The number of samples per channel
+ * @param size The frame size
+ * @param periods The number of periods of the sinusoid of each channel in a frame
+ * @param amplitude The amplitude, relative to full scale
+ * @return The samples
+ */
+template <typename Sample>
+std::vector<Sample>
+make_recording(std::size_t samples, std::size_t size, const std::vector<double>& periods, double amplitude)
+{
+    const double        full = std::is_same_v<Sample, int16_t> ? 0x1p15 : 0x1p31;
+    std::vector<Sample> recording(samples * periods.size());
+    for (std::size_t i = 0; i < samples; ++i) {
+        for (std::size_t c = 0; c < periods.size(); ++c) {
+            const auto phase = 2 * std::numbers::pi * periods[c] * i / size;
+            recording[i * periods.size() + c] = static_cast<Sample>(std::lround(amplitude * full * std::sin(phase)));
+        }
+    }
+    return recording;
+}
+
+/**
+ * @brief Writes samples to a raw file in the temporary directory
+ *
+ * @param name The name of the file
+ * @param samples The samples
+ * @return The path of the file
+ */
+template <typename Sample>
+std::string
+write_recording(const std::string& name, const std::vector<Sample>& samples)
+{
+    const auto    path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(Sample));
+    return path;
+}
+
+class TestSpectrogram : public ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(TestSpectrogram, MatchesDoublePrecision)
+{
+    SpectrogramOptions options;
+    options.size         = GetParam();
+    options.hop          = GetParam() / 4;
+    const auto recording = make_recording<int16_t>(4 * GetParam(), GetParam(), {GetParam() / 16 + 0.3}, 0.5);
+    const auto frames    = fft_utils::spectrogram_frames(recording.size(), options);
+    const auto bins      = GetParam() / 2 + 1;
+    ThreadPool pool(4);
+
+    std::vector<float> fixed(frames * bins);
+    std::vector<float> reference(frames * bins);
+    EXPECT_EQ(compute_spectrogram<Complex>(std::span<const int16_t>(recording), options, pool, std::span(fixed)), 13u);
+    compute_spectrogram<std::complex<double>>(std::span<const int16_t>(recording), options, pool, std::span(reference));
+
+    for (std::size_t i = 0; i < fixed.size(); ++i) {
+        EXPECT_NEAR(fixed[i], reference[i], k_magnitude_tolerance * GetParam()) << "bin " << i % bins;
+    }
+}
+
+TEST_P(TestSpectrogram, WritesTheFileOfASinusoid)
+{
+    SpectrogramOptions options;
+    options.size          = GetParam();
+    options.hop           = GetParam() / 2;
+    options.sampling_rate = 48000;
+    const auto bin        = GetParam() / 8;
+    const auto input      = write_recording("fftemb_spectrogram_" + std::to_string(GetParam()) + ".raw",
+                                       make_recording<int16_t>(5 * GetParam() + 7, GetParam(), {double(bin)}, 0.5));
+    const auto output     = input + ".spec";
+    ThreadPool pool(3);
+
+    SpectrogramHeader header{};
+    ASSERT_EQ(write_spectrogram(input.c_str(), output.c_str(), options, pool, header), SpectrogramStatus::ok);
+
+    const MappedFile spectrogram(output.c_str());
+    ASSERT_TRUE(spectrogram.is_open());
+    SpectrogramHeader written;
+    std::memcpy(&written, spectrogram.bytes().data(), sizeof(written));
+    EXPECT_EQ(written.magic, k_spectrogram_magic);
+    EXPECT_EQ(written.size, GetParam());
+    EXPECT_EQ(written.bins, GetParam() / 2 + 1);
+    EXPECT_EQ(written.frames, 9u);
+    EXPECT_EQ(written.samples, 5 * GetParam() + 7);
+    EXPECT_EQ(written.sampling_rate, 48000);
+    EXPECT_EQ(written.frames, header.frames);
+    ASSERT_EQ(spectrogram.size(), sizeof(SpectrogramHeader) + written.frames * written.bins * sizeof(float));
+
+    // a sinusoid of half the full scale on a bin reads N/4 there
+    const auto* rows = reinterpret_cast<const float*>(spectrogram.bytes().data() + sizeof(SpectrogramHeader));
+    for (std::size_t f = 0; f < written.frames; ++f) {
+        const auto* row = rows + f * written.bins;
+        EXPECT_EQ(std::max_element(row, row + written.bins) - row, bin) << "frame " << f;
+        EXPECT_NEAR(row[bin], GetParam() / 4.0, k_magnitude_tolerance * GetParam()) << "frame " << f;
+    }
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+INSTANTIATE_TEST_CASE_P(SpectrogramTests, TestSpectrogram, ::testing::Values(256, 1024, 4096));
+
+TEST(SpectrogramFiles, SelectsAChannelOfInt32Samples)
+{
+    SpectrogramOptions options;
+    options.size     = 512;
+    options.hop      = 512;
+    options.channels = 2;
+    options.channel  = 1;
+    options.format   = SampleFormat::int32;
+    options.scale    = SpectrogramScale::db;
+    const auto input = write_recording("fftemb_spectrogram_stereo.raw",
+                                       make_recording<int32_t>(2048, 512, {10, 100}, 0.25));
+    const auto output = input + ".spec";
+    ThreadPool pool(2);
+
+    SpectrogramHeader header{};
+    ASSERT_EQ(write_spectrogram(input.c_str(), output.c_str(), options, pool, header), SpectrogramStatus::ok);
+    EXPECT_EQ(header.frames, 4u);
+    EXPECT_EQ(header.channel, 1u);
+
+    const MappedFile spectrogram(output.c_str());
+    ASSERT_TRUE(spectrogram.is_open());
+    const auto* rows = reinterpret_cast<const float*>(spectrogram.bytes().data() + sizeof(SpectrogramHeader));
+    for (std::size_t f = 0; f < header.frames; ++f) {
+        const auto* row = rows + f * header.bins;
+        EXPECT_EQ(std::max_element(row, row + header.bins) - row, 100);
+        EXPECT_NEAR(row[100], 20 * std::log10(512 / 8.0), 0.01);
+    }
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST(SpectrogramFiles, ShortRecordingHasNoFrames)
+{
+    SpectrogramOptions options;
+    const auto         input  = write_recording("fftemb_spectrogram_short.raw", std::vector<int16_t>(1000));
+    const auto         output = input + ".spec";
+    ThreadPool         pool(2);
+
+    SpectrogramHeader header{};
+    ASSERT_EQ(write_spectrogram(input.c_str(), output.c_str(), options, pool, header), SpectrogramStatus::ok);
+
+    EXPECT_EQ(header.frames, 0u);
+    EXPECT_EQ(std::filesystem::file_size(output), sizeof(SpectrogramHeader));
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST(SpectrogramFiles, ReportsInvalidOptionsAndMissingInput)
+{
+    ThreadPool        pool(1);
+    SpectrogramHeader header{};
+    SpectrogramOptions options;
+    const auto         output = (std::filesystem::temp_directory_path() / "fftemb_spectrogram_none.spec").string();
+
+    EXPECT_EQ(write_spectrogram("/nonexistent/recording.raw", output.c_str(), options, pool, header),
+              SpectrogramStatus::input_error);
+    options.size = 1000;
+    EXPECT_EQ(write_spectrogram("/nonexistent/recording.raw", output.c_str(), options, pool, header),
+              SpectrogramStatus::invalid_options);
+    options.size    = 1024;
+    options.channel = 1;
+    EXPECT_EQ(write_spectrogram("/nonexistent/recording.raw", output.c_str(), options, pool, header),
+              SpectrogramStatus::invalid_options);
+}
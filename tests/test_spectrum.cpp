@@ -0,0 +1,124 @@
+/**
+ * @file test_spectrum.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the batch spectrum kernels
+ */
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numbers>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "spectrum.hpp"
+#include "utils/include/testing_utils.hpp"
+
+using namespace fftemb;
+
+// error tolerances
+constexpr auto k_power_tolerance = 1e-6;
+
+class TestSpectrum : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+    /**
+     * @brief Computes the spectrum of two sinusoids, with bins of every phase
+     *
+     * @param size The transform size
+     * @return The spectrum
+     */
+    template <typename T>
+    static std::vector<T>
+    spectrum(std::size_t size)
+    {
+        std::vector<T> signal(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            const auto t = 2 * std::numbers::pi * i / size;
+            signal[i]    = T(std::cos(3.3 * t + 0.2) + 0.5 * std::sin(11.7 * t), 0.25 * std::cos(5 * t));
+        }
+        compute(signal);
+        return signal;
+    }
+};
+
+TEST_P(TestSpectrum, PowerMatchesSquaredMagnitude)
+{
+    const auto         input = spectrum<Complex>(GetParam());
+    std::vector<float> power(input.size());
+
+    fft_utils::power_spectrum(input, power);
+
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        const auto expected = std::norm(test_utils::to_complex(input[i]));
+        EXPECT_NEAR(power[i], expected, k_power_tolerance * (1 + expected));
+    }
+}
+
+TEST_P(TestSpectrum, PowerOfFloatingPointMatchesNorm)
+{
+    const auto         input = spectrum<std::complex<double>>(GetParam());
+    std::vector<float> power(input.size());
+
+    fft_utils::power_spectrum(input, power);
+
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        EXPECT_NEAR(power[i], std::norm(input[i]), k_power_tolerance * (1 + std::norm(input[i])));
+    }
+}
+
+TEST_P(TestSpectrum, ApproximateMagnitudeIsWithinBound)
+{
+    const auto         input = spectrum<Complex>(GetParam());
+    std::vector<float> magnitude(input.size());
+
+    fft_utils::magnitude_spectrum_approx(input, magnitude);
+
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        const auto expected = std::abs(test_utils::to_complex(input[i]));
+        EXPECT_NEAR(magnitude[i], expected, fft_utils::k_magnitude_error * expected + 1e-6);
+    }
+}
+
+TEST_P(TestSpectrum, DbIsWithinBound)
+{
+    const auto         input = spectrum<std::complex<float>>(GetParam());
+    std::vector<float> db(input.size());
+
+    fft_utils::db_spectrum(input, db);
+
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        const auto expected = 10 * std::log10(std::norm(std::complex<double>(input[i])));
+        EXPECT_NEAR(db[i], expected, fft_utils::k_db_error);
+    }
+}
+
+TEST_P(TestSpectrum, NormalizeScalesLargestBinToUnity)
+{
+    auto input = spectrum<Complex>(GetParam());
+    auto peak  = 0.0;
+    for (const auto& bin : input) {
+        peak = std::max(peak, std::abs(test_utils::to_complex(bin)));
+    }
+
+    const auto amplitude = fft_utils::normalize(input);
+
+    EXPECT_NEAR(static_cast<double>(amplitude), peak, 1e-4 * peak);
+    auto normalized_peak = 0.0;
+    for (const auto& bin : input) {
+        normalized_peak = std::max(normalized_peak, std::abs(test_utils::to_complex(bin)));
+    }
+    EXPECT_NEAR(normalized_peak, 1, 1e-4);
+}
+
+TEST(TestPowerToDb, ZeroAndExactPowers)
+{
+    EXPECT_EQ(fft_utils::power_to_db(0), -std::numeric_limits<float>::infinity());
+    for (const auto power : {1e-12f, 1e-3f, 0.5f, 1.0f, 3.0f, 1e6f}) {
+        EXPECT_NEAR(fft_utils::power_to_db(power), 10 * std::log10(power), fft_utils::k_db_error);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Spectrum, TestSpectrum, ::testing::Values(16, 64, 256, 1024));
@@ -0,0 +1,76 @@
+/**
+ * @file test_spsc_queue.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the SpscQueue class
+ */
+
+#include <cstdint>
+#include <thread>
+#include "gtest/gtest.h"
+#include "spsc_queue.hpp"
+
+using namespace fftemb;
+
+TEST(SpscQueueTest, KeepsTheOrderUpToItsCapacity)
+{
+    SpscQueue<uint32_t, 8> queue;
+    uint32_t               value = 0;
+
+    EXPECT_FALSE(queue.try_pop(value));
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(8));
+    EXPECT_EQ(queue.size(), 8u);
+
+    for (uint32_t i = 0; i < 8; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(SpscQueueTest, WrapsAroundTheSlots)
+{
+    SpscQueue<uint32_t, 4> queue;
+    uint32_t               value = 0;
+    for (uint32_t i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.try_push(i));
+        ASSERT_TRUE(queue.try_push(i + 1000));
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i + 1000);
+    }
+}
+
+TEST(SpscQueueTest, HandsEveryElementOverBetweenTwoThreads)
+{
+    constexpr uint32_t      count = 1000000;
+    SpscQueue<uint32_t, 64> queue;
+
+    std::thread producer([&queue] {
+        for (uint32_t i = 0; i < count;) {
+            if (queue.try_push(i)) {
+                ++i;
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected = 0;
+    uint32_t value    = 0;
+    while (expected < count) {
+        if (queue.try_pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(queue.try_pop(value));
+}
@@ -0,0 +1,133 @@
+/**
+ * @file test_streaming_stft.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the StreamingStft class
+ */
+
+#include <chrono>
+#include <complex>
+#include <memory>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "etl/vector.h"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "streaming_stft.hpp"
+#include "utils/include/signal_generator.hpp"
+#include "window.hpp"
+
+using SignalParameters = std::vector<std::pair<double, double>>;
+using namespace fftemb;
+
+// frame size
+constexpr std::size_t k_frame_size = 256;
+
+// signal generator
+constexpr std::chrono::nanoseconds k_duration        = std::chrono::milliseconds(2000);
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::milliseconds(1);
+
+class TestStreamingStft : public ::testing::TestWithParam<std::pair<std::size_t, std::size_t>>
+{
+protected:
+    /**
+     * @brief Streams a signal in chunks of a fixed size, collecting the emitted spectra
+     *
+     * @param stft The streaming STFT
+     * @param signal The signal
+     * @param chunk_size The number of samples of each chunk
+     * @return The spectra
+     */
+    static std::vector<std::vector<Complex>>
+    stream(StreamingStft<k_frame_size>& stft, const std::vector<Complex>& signal, std::size_t chunk_size)
+    {
+        std::vector<std::vector<Complex>> spectra;
+        std::vector<Complex>              chunk;
+        for (std::size_t offset = 0; offset < signal.size(); offset += chunk_size) {
+            chunk.assign(signal.begin() + offset, signal.begin() + std::min(offset + chunk_size, signal.size()));
+            stft.push(chunk, [&spectra](const auto& spectrum) {
+                spectra.emplace_back(spectrum.begin(), spectrum.end());
+            });
+        }
+        return spectra;
+    }
+
+    /**
+     * @brief Generates the test signal
+     *
+     * @return The signal
+     */
+    static std::vector<Complex>
+    generate()
+    {
+        std::vector<Complex> signal(k_duration / k_sampling_period);
+        SignalGenerator<Complex, std::vector>(k_duration, k_sampling_period)
+            .generate_sine_wave(signal, SignalParameters{{1, 60}, {0.5, 200}});
+        return signal;
+    }
+};
+
+TEST_P(TestStreamingStft, FramesMatchOfflineTransform)
+{
+    const auto [hop, chunk_size] = GetParam();
+    const auto signal            = generate();
+    const auto plan              = std::make_unique<FftPlan<k_frame_size>>();
+    auto       stft              = std::make_unique<StreamingStft<k_frame_size>>(hop, WindowType::hann);
+
+    const auto spectra = stream(*stft, signal, chunk_size);
+
+    ASSERT_EQ(spectra.size(), 1 + (signal.size() - k_frame_size) / hop);
+    for (std::size_t frame = 0; frame < spectra.size(); ++frame) {
+        std::vector<Complex> reference(signal.begin() + frame * hop, signal.begin() + frame * hop + k_frame_size);
+        fft_utils::apply_window(reference, WindowType::hann);
+        plan->execute(reference);
+        EXPECT_EQ(spectra[frame], reference) << "frame " << frame;
+    }
+}
+
+TEST_P(TestStreamingStft, ChunkSizeDoesNotChangeSpectra)
+{
+    const auto hop    = GetParam().first;
+    const auto signal = generate();
+    auto       stft   = std::make_unique<StreamingStft<k_frame_size>>(hop);
+
+    const auto chunked_spectra = stream(*stft, signal, GetParam().second);
+    stft->reset();
+    const auto whole_spectra = stream(*stft, signal, signal.size());
+
+    EXPECT_EQ(chunked_spectra, whole_spectra);
+}
+
+TEST(TestStreamingStftScale, InputScaleIsFoldedIntoWindow)
+{
+    std::vector<Complex> signal(k_frame_size, Complex(1, 0));
+    auto                 stft = std::make_unique<StreamingStft<k_frame_size>>(k_frame_size, WindowType::hann, 0.25);
+    std::vector<Complex> spectrum;
+
+    const auto emitted = stft->push(signal, [&spectrum](const auto& bins) {
+        spectrum.assign(bins.begin(), bins.end());
+    });
+
+    ASSERT_EQ(emitted, 1);
+    EXPECT_NEAR(static_cast<double>(spectrum[0].real()), 0.25 * k_frame_size, 1e-3);
+}
+
+TEST(TestStreamingStftScale, ZeroHopIsTakenAsOne)
+{
+    std::vector<std::complex<float>> signal(k_frame_size + 1, std::complex<float>(1, 0));
+    auto stft = std::make_unique<StreamingStft<k_frame_size, std::complex<float>>>(0, WindowType::hann, 0.5);
+
+    const auto emitted = stft->push(signal, [](const auto&) {});
+
+    EXPECT_EQ(stft->hop(), 1);
+    EXPECT_EQ(emitted, 2);
+}
+
+INSTANTIATE_TEST_CASE_P(HopsAndChunks,
+                        TestStreamingStft,
+                        ::testing::Values(std::make_pair(k_frame_size / 4, 1),
+                                          std::make_pair(k_frame_size / 4, 100),
+                                          std::make_pair(k_frame_size / 2, 37),
+                                          std::make_pair(k_frame_size, 256),
+                                          std::make_pair(3 * k_frame_size / 2, 1000),
+                                          std::make_pair(1, 64)));
@@ -0,0 +1,60 @@
+/**
+ * @file test_thread_pool.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the ThreadPool class
+ */
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "thread_pool.hpp"
+
+using namespace fftemb;
+
+class TestThreadPool : public ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(TestThreadPool, EveryIndexRunsOnce)
+{
+    ThreadPool       pool(GetParam());
+    std::vector<int> calls(10000, 0);
+
+    pool.parallel_for(calls.size(), [&calls](std::size_t i) { ++calls[i]; });
+
+    EXPECT_EQ(pool.size(), GetParam());
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), 1), calls.size());
+}
+
+TEST_P(TestThreadPool, UnevenWorkIsStolen)
+{
+    ThreadPool               pool(GetParam());
+    std::atomic<std::size_t> sum{0};
+
+    // the first indices are much slower, so the other threads must steal them to finish
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        pool.parallel_for(64, [&sum](std::size_t i) {
+            if (i < 4) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            sum += i;
+        });
+    }
+
+    EXPECT_EQ(sum, 3 * 63 * 64 / 2);
+}
+
+TEST_P(TestThreadPool, NestedLoopsComplete)
+{
+    ThreadPool               pool(GetParam());
+    std::atomic<std::size_t> calls{0};
+
+    pool.parallel_for(1, [&](std::size_t) { pool.parallel_for(100, [&calls](std::size_t) { ++calls; }); });
+
+    EXPECT_EQ(calls, 100);
+}
+
+INSTANTIATE_TEST_CASE_P(ThreadCounts, TestThreadPool, ::testing::Values(1, 2, 4, 8));
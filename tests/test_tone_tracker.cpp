@@ -0,0 +1,182 @@
+/**
+ * @file test_tone_tracker.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the Goertzel and SlidingDft classes
+ */
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <numbers>
+#include <vector>
+#include "fft.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "tone_tracker.hpp"
+#include "utils/include/testing_utils.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+
+// block size
+constexpr std::size_t k_block_size = 256;
+
+// sampling period
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::milliseconds(1);
+
+// tracked frequencies, at bins 15.36 (the line frequency), 30 and 64
+constexpr std::array<double, 3> k_frequencies{60, 117.1875, 250};
+
+// error tolerances
+constexpr auto k_bin_tolerance       = 2e-3;
+constexpr auto k_sliding_tolerance   = 5e-3;
+constexpr auto k_amplitude_tolerance = 0.01;
+
+/**
+ * @brief Generates the sum of two sinusoids, one of them at the line frequency
+ *
+ * @param size The number of samples
+ * @return The signal
+ */
+std::vector<Complex>
+generate(std::size_t size)
+{
+    std::vector<Complex> signal(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        const auto t = 2 * std::numbers::pi * std::chrono::duration<double>(k_sampling_period).count() * i;
+        signal[i]    = Complex(std::cos(60 * t + 0.3) + 0.5 * std::sin(250 * t), 0);
+    }
+    return signal;
+}
+
+/**
+ * @brief Computes the windowed spectrum of the block of N samples ending at an index
+ *
+ * @param signal The signal
+ * @param end The index past the last sample of the block
+ * @param window The window function
+ * @return The spectrum
+ */
+std::vector<Complex>
+reference_spectrum(const std::vector<Complex>& signal, std::size_t end, WindowType window)
+{
+    std::vector<Complex> block(signal.begin() + (end - k_block_size), signal.begin() + end);
+    fft_utils::apply_window(block, window);
+    compute(block);
+    return block;
+}
+
+class TestGoertzel : public ::testing::TestWithParam<WindowType>
+{
+};
+
+class TestSlidingDft : public ::testing::TestWithParam<WindowType>
+{
+};
+
+TEST_P(TestGoertzel, BinsMatchTransform)
+{
+    const auto signal   = generate(2 * k_block_size);
+    auto       goertzel = std::make_unique<Goertzel<k_block_size, 3>>(k_frequencies, k_sampling_period, GetParam());
+
+    std::vector<std::array<Complex, 3>> blocks;
+    goertzel->push(signal, [&blocks](const auto& bins) { blocks.push_back(bins); });
+
+    ASSERT_EQ(blocks.size(), 2);
+    for (std::size_t block = 0; block < blocks.size(); ++block) {
+        const auto spectrum = reference_spectrum(signal, (block + 1) * k_block_size, GetParam());
+        // the frequencies on the bins
+        for (const auto& [tone, bin] : {std::pair{1, 30}, std::pair{2, 64}}) {
+            const auto error = test_utils::to_complex(blocks[block][tone]) - test_utils::to_complex(spectrum[bin]);
+            EXPECT_NEAR(std::abs(error), 0, k_bin_tolerance * k_block_size);
+        }
+    }
+}
+
+TEST_P(TestGoertzel, ChunksMatchSingleBlock)
+{
+    const auto signal  = generate(k_block_size);
+    auto       whole   = std::make_unique<Goertzel<k_block_size, 3>>(k_frequencies, k_sampling_period, GetParam());
+    auto       chunked = std::make_unique<Goertzel<k_block_size, 3>>(k_frequencies, k_sampling_period, GetParam());
+    const auto ignore  = [](const auto&) {};
+
+    whole->push(signal, ignore);
+    std::size_t completed = 0;
+    for (std::size_t offset = 0; offset < signal.size(); offset += 37) {
+        const auto                 end = std::min(offset + 37, signal.size());
+        const std::vector<Complex> chunk(signal.begin() + offset, signal.begin() + end);
+        completed += chunked->push(chunk, ignore);
+    }
+
+    EXPECT_EQ(completed, 1);
+    EXPECT_EQ(whole->bins(), chunked->bins());
+}
+
+TEST_P(TestGoertzel, ToneBetweenBinsHasItsAmplitude)
+{
+    auto goertzel = std::make_unique<Goertzel<k_block_size, 3>>(k_frequencies, k_sampling_period, GetParam());
+    goertzel->push(generate(k_block_size), [](const auto&) {});
+
+    // evaluated at its own frequency, the tone is not attenuated by the scalloping of the window
+    const auto line = goertzel->tone(0);
+    EXPECT_DOUBLE_EQ(line.frequency, 60);
+    EXPECT_NEAR(line.bin, 15.36, 1e-9);
+    EXPECT_NEAR(line.amplitude, 1, GetParam() == WindowType::rectangular ? 0.05 : k_amplitude_tolerance);
+    EXPECT_NEAR(goertzel->tone(2).amplitude, 0.5, k_amplitude_tolerance);
+}
+
+TEST_P(TestSlidingDft, BinsMatchTransformAsWindowSlides)
+{
+    const auto signal  = generate(3 * k_block_size);
+    auto       sliding = std::make_unique<SlidingDft<k_block_size, 3>>(k_frequencies, k_sampling_period, GetParam());
+
+    for (std::size_t i = 0; i < signal.size(); ++i) {
+        sliding->update(signal[i]);
+        if (i + 1 >= k_block_size && (i + 1) % 61 == 0) {
+            const auto spectrum = reference_spectrum(signal, i + 1, GetParam());
+            for (const auto& [tone, bin] : {std::pair{1, 30}, std::pair{2, 64}}) {
+                const auto error = test_utils::to_complex(sliding->bin(tone)) - test_utils::to_complex(spectrum[bin]);
+                EXPECT_NEAR(std::abs(error), 0, k_sliding_tolerance * k_block_size);
+            }
+        }
+    }
+}
+
+TEST_P(TestSlidingDft, MatchesGoertzelBetweenBins)
+{
+    const auto signal   = generate(2 * k_block_size);
+    auto       sliding  = std::make_unique<SlidingDft<k_block_size, 3>>(k_frequencies, k_sampling_period, GetParam());
+    auto       goertzel = std::make_unique<Goertzel<k_block_size, 3>>(k_frequencies, k_sampling_period, GetParam());
+
+    sliding->push(signal);
+    goertzel->push(signal, [](const auto&) {});
+
+    const auto error = test_utils::to_complex(sliding->bin(0)) - test_utils::to_complex(goertzel->bins()[0]);
+    EXPECT_NEAR(std::abs(error), 0, k_sliding_tolerance * k_block_size);
+    EXPECT_NEAR(sliding->tone(0).amplitude, goertzel->tone(0).amplitude, k_sliding_tolerance);
+}
+
+TEST_P(TestSlidingDft, ResetClearsHistory)
+{
+    auto sliding = std::make_unique<SlidingDft<k_block_size, 3>>(k_frequencies, k_sampling_period, GetParam());
+    sliding->push(generate(k_block_size));
+
+    sliding->reset();
+
+    for (std::size_t k = 0; k < k_frequencies.size(); ++k) {
+        EXPECT_EQ(sliding->bin(k), Complex(0, 0));
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Goertzel,
+                        TestGoertzel,
+                        ::testing::Values(WindowType::rectangular, WindowType::hann, WindowType::flat_top));
+
+INSTANTIATE_TEST_CASE_P(SlidingDft,
+                        TestSlidingDft,
+                        ::testing::Values(WindowType::rectangular,
+                                          WindowType::hann,
+                                          WindowType::blackman_harris,
+                                          WindowType::flat_top));
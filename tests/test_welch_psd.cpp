@@ -0,0 +1,141 @@
+/**
+ * @file test_welch_psd.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the WelchPsd class
+ */
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <numeric>
+#include <vector>
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "welch_psd.hpp"
+#include "window.hpp"
+
+using namespace fftemb;
+
+// frame size
+constexpr std::size_t k_frame_size = 256;
+
+// sampling period
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::microseconds(100);
+
+// error tolerances
+constexpr auto k_noise_tolerance = 0.05;
+constexpr auto k_type_tolerance  = 1e-3;
+
+/**
+ * @brief Generates a reproducible uniform white noise with a sinusoid on bin 32
+ *
+ * @param size The number of samples
+ * @param noise The half width of the uniform noise, whose variance is noise² / 3
+ * @param amplitude The amplitude of the sinusoid
+ * @return The signal
+ */
+template <typename T = Complex>
+std::vector<T>
+generate(std::size_t size, double noise, double amplitude)
+{
+    std::vector<T> signal(size);
+    uint32_t       state = 12345;
+    for (std::size_t i = 0; i < size; ++i) {
+        state               = state * 1664525u + 1013904223u;
+        const auto uniform  = 2 * (state / 4294967296.0) - 1;
+        const auto sinusoid = amplitude * std::cos(2 * std::numbers::pi * 32 * i / k_frame_size);
+        signal[i]           = T(noise * uniform + sinusoid, 0);
+    }
+    return signal;
+}
+
+/**
+ * @brief Pushes a signal in chunks of 100 samples and gets the density
+ *
+ * @param psd The Welch PSD
+ * @param signal The signal
+ * @return The density of each bin
+ */
+template <typename T>
+std::vector<float>
+estimate(WelchPsd<k_frame_size, T>& psd, const std::vector<T>& signal)
+{
+    for (std::size_t offset = 0; offset < signal.size(); offset += 100) {
+        const std::vector<T> chunk(signal.begin() + offset, signal.begin() + std::min(offset + 100, signal.size()));
+        psd.push(chunk);
+    }
+    std::vector<float> density(k_frame_size);
+    psd.density(density, k_sampling_period);
+    return density;
+}
+
+class TestWelchPsd : public ::testing::TestWithParam<std::size_t>
+{
+};
+
+TEST_P(TestWelchPsd, WhiteNoiseDensityIsItsVarianceOverTheRate)
+{
+    WelchPsd<k_frame_size> psd(GetParam());
+    const auto             density = estimate(psd, generate(200 * k_frame_size, 0.5, 0));
+
+    EXPECT_EQ(psd.frames(), (200 * k_frame_size - k_frame_size) / GetParam() + 1);
+    const auto expected = 0.25 / 3 * 1e-4;
+    const auto mean     = std::accumulate(density.begin(), density.end(), 0.0) / density.size();
+    EXPECT_NEAR(mean, expected, k_noise_tolerance * expected);
+}
+
+TEST_P(TestWelchPsd, FixedPointMatchesDoublePrecision)
+{
+    WelchPsd<k_frame_size>                       fixed(GetParam());
+    WelchPsd<k_frame_size, std::complex<double>> reference(GetParam());
+
+    const auto density  = estimate(fixed, generate(50 * k_frame_size, 0.25, 0.5));
+    const auto expected = estimate(reference, generate<std::complex<double>>(50 * k_frame_size, 0.25, 0.5));
+
+    for (std::size_t k = 0; k < k_frame_size; ++k) {
+        EXPECT_NEAR(density[k], expected[k], k_type_tolerance * expected[k] + 1e-12) << "bin " << k;
+    }
+}
+
+TEST_P(TestWelchPsd, ExponentialAveragingTracksAChange)
+{
+    WelchPsd<k_frame_size> psd(GetParam(), WindowType::hann, PsdAveraging::exponential, 3);
+
+    // the sinusoid fits the frames, so every spectrum is the same and the average starts at its steady state
+    const auto before = estimate(psd, generate(20 * k_frame_size, 0, 0.25));
+    const auto after  = estimate(psd, generate(60 * k_frame_size, 0, 0.5));
+
+    // a Hann-windowed sinusoid of amplitude A on a bin: (A N / 2)² Ts / Σw², with Σw² = 1.5 N after gain correction
+    const auto expected = std::pow(0.25 * k_frame_size / 2, 2) * 1e-4 / (1.5 * k_frame_size);
+    EXPECT_NEAR(before[32], expected, k_type_tolerance * expected);
+    EXPECT_NEAR(after[32], 4 * expected, 0.01 * 4 * expected);
+}
+
+INSTANTIATE_TEST_CASE_P(WelchPsdTests, TestWelchPsd, ::testing::Values(64, 128, 256));
+
+TEST(WelchPsdAveraging, LinearAndExponentialAgreeOnAStationarySignal)
+{
+    WelchPsd<k_frame_size> linear(k_frame_size / 2);
+    WelchPsd<k_frame_size> exponential(k_frame_size / 2, WindowType::hann, PsdAveraging::exponential, 4);
+    const auto             signal = generate(40 * k_frame_size, 0, 0.75);
+
+    const auto a = estimate(linear, signal);
+    const auto b = estimate(exponential, signal);
+
+    EXPECT_NEAR(a[32], b[32], k_type_tolerance * a[32]);
+}
+
+TEST(WelchPsdAveraging, ResetDiscardsTheSpectra)
+{
+    WelchPsd<k_frame_size> psd(k_frame_size);
+    estimate(psd, generate(10 * k_frame_size, 0.5, 0.5));
+
+    psd.reset();
+    const auto density = estimate(psd, generate(10 * k_frame_size, 0, 0.25));
+
+    EXPECT_EQ(psd.frames(), 10u);
+    const auto expected = std::pow(0.25 * k_frame_size / 2, 2) * 1e-4 / (1.5 * k_frame_size);
+    EXPECT_NEAR(density[32], expected, k_type_tolerance * expected);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_window.cpp
+ * @author Eduardo Vieira Falcão
+ * @brief Unit tests for the window functions
+ */
+
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include "dsp_utils.hpp"
+#include "fft.hpp"
+#include "fft_plan.hpp"
+#include "fft_types.hpp"
+#include "gtest/gtest.h"
+#include "utils/include/signal_generator.hpp"
+#include "utils/include/testing_utils.hpp"
+#include "window.hpp"
+
+using SignalParameters = std::vector<std::pair<double, double>>;
+using namespace fftemb;
+
+// buffer size
+constexpr std::size_t k_buffer_size = 1024;
+
+// error tolerances
+constexpr auto k_coefficient_tolerance = 1e-5;
+constexpr auto k_peak_tolerance        = 0.17;
+constexpr auto k_flat_top_tolerance    = 0.01;
+
+// signal generator
+constexpr std::chrono::nanoseconds k_duration        = std::chrono::milliseconds(k_buffer_size - 1);
+constexpr std::chrono::nanoseconds k_sampling_period = std::chrono::milliseconds(1);
+
+class TestWindow : public ::testing::TestWithParam<WindowType>
+{
+};
+
+TEST_P(TestWindow, TableHasUnitCoherentGain)
+{
+    const auto& table = window_table(GetParam(), k_buffer_size);
+    double      sum   = 0;
+    for (std::size_t i = 0; i < k_buffer_size; ++i) {
+        sum += static_cast<double>(table[i]);
+    }
+
+    ASSERT_EQ(table.size(), k_buffer_size);
+    EXPECT_NEAR(sum / k_buffer_size, 1, k_coefficient_tolerance);
+}
+
+TEST_P(TestWindow, TableIsPeriodicAndSymmetric)
+{
+    const auto& table = window_table(GetParam(), k_buffer_size);
+    for (std::size_t i = 1; i < k_buffer_size; ++i) {
+        EXPECT_EQ(table[i], table[k_buffer_size - i]) << "coefficient " << i;
+    }
+    EXPECT_LT(table[0], table[k_buffer_size / 2]);
+}
+
+TEST_P(TestWindow, TableIsCachedBySize)
+{
+    const auto& table = window_table(GetParam(), k_buffer_size);
+
+    EXPECT_EQ(&window_table(GetParam(), k_buffer_size), &table);
+    EXPECT_NE(&window_table(GetParam(), k_buffer_size / 2), &table);
+    EXPECT_EQ(&window_table(GetParam(), k_buffer_size), &table);
+}
+
+TEST_P(TestWindow, TableIsSharedAcrossThreads)
+{
+    const auto&                                       table = window_table(GetParam(), k_buffer_size);
+    const std::vector<safe_rounding_elastic_integer>* other = nullptr;
+
+    std::thread thread([&] { other = &window_table(GetParam(), k_buffer_size); });
+    thread.join();
+
+    EXPECT_EQ(other, &table);
+}
+
+TEST_P(TestWindow, PeakAmplitudeIsCorrected)
+{
+    std::vector<Complex> test_signal(k_buffer_size);
+    SignalParameters     signal_parameters{{1, 125}};
+    SignalGenerator<Complex, std::vector>(k_duration, k_sampling_period)
+        .generate_sine_wave(test_signal, signal_parameters);
+
+    fft_utils::apply_window(test_signal, GetParam());
+    compute(test_signal);
+
+    const auto peak_data = test_utils::find_peaks(test_signal, k_sampling_period, signal_parameters.size());
+    const auto errors    = test_utils::calculate_error(peak_data, signal_parameters);
+    EXPECT_LE(errors[0].first, k_peak_tolerance);
+}
+
+TEST_P(TestWindow, FusedWindowMatchesSeparatePass)
+{
+    const auto           plan = std::make_unique<FftPlan<k_buffer_size>>();
+    std::vector<Complex> test_signal(k_buffer_size);
+    SignalGenerator<Complex, std::vector>(k_duration, k_sampling_period)
+        .generate_sine_wave(test_signal, SignalParameters{{1, 60}, {0.5, 200}});
+    auto reference_signal = test_signal;
+
+    const auto& table = window_table(GetParam(), k_buffer_size);
+    std::array<safe_rounding_elastic_integer, k_buffer_size> window;
+    std::copy(table.begin(), table.end(), window.begin());
+    fft_utils::apply_window(reference_signal, GetParam());
+    plan->execute(reference_signal);
+    plan->execute(test_signal, window);
+
+    EXPECT_EQ(test_signal, reference_signal);
+}
+
+TEST(TestWindowTable, CompileTimeSizeMatchesRunTimeSize)
+{
+    const auto& static_table = window_table<WindowType::blackman_harris, 256>();
+    const auto& table        = window_table(WindowType::blackman_harris, 256);
+
+    EXPECT_EQ((&window_table<WindowType::blackman_harris, 256>()), &static_table);
+    EXPECT_TRUE(std::equal(static_table.begin(), static_table.end(), table.begin()));
+}
+
+TEST(TestWindowTable, FlatTopAmplitudeBetweenBins)
+{
+    // half a bin off, where the other windows underestimate the amplitude the most
+    constexpr auto       frequency = 125.5 * 1000 / k_buffer_size;
+    std::vector<Complex> test_signal(k_buffer_size);
+    SignalGenerator<Complex, std::vector>(k_duration, k_sampling_period)
+        .generate_sine_wave(test_signal, SignalParameters{{1, frequency}});
+
+    fft_utils::apply_window(test_signal, WindowType::flat_top);
+    compute(test_signal);
+
+    const auto peak_data = test_utils::find_peaks(test_signal, k_sampling_period, 1);
+    EXPECT_NEAR(peak_data[0].first, 1, k_flat_top_tolerance);
+}
+
+TEST(TestWindowTable, HannWindowMatchesTable)
+{
+    std::vector<Complex> test_signal(k_buffer_size, Complex(1, 0));
+    const auto&          table = window_table(WindowType::hann, k_buffer_size);
+
+    fft_utils::apply_hann_window(test_signal);
+
+    for (std::size_t i = 0; i < k_buffer_size; ++i) {
+        EXPECT_EQ(test_signal[i], Complex(table[i], 0)) << "sample " << i;
+    }
+    EXPECT_EQ(test_signal[0], Complex(0, 0));
+    EXPECT_NEAR(static_cast<double>(test_signal[k_buffer_size / 2].real()), 2, k_coefficient_tolerance);
+}
+
+INSTANTIATE_TEST_CASE_P(WindowTypes,
+                        TestWindow,
+                        ::testing::Values(WindowType::hann,
+                                          WindowType::hamming,
+                                          WindowType::blackman_harris,
+                                          WindowType::flat_top));
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <complex>
 #include <vector>
 
 namespace fftemb::test_utils
@@ -29,6 +30,38 @@ calculate_error(const std::vector<std::pair<double, double>>& data,
 void
 sort_pairs(std::vector<std::pair<double, double>>& pairs_vector);
 
+/**
+ * @brief Calculates the DFT in double precision, with the same sign convention as fftemb::compute
+ *
+ * @param sequence The sequence of elements
+ * @return The spectrum
+ */
+std::vector<std::complex<double>>
+reference_dft(const std::vector<std::complex<double>>& sequence);
+
+/**
+ * @brief Calculates the signal-to-noise ratio of a sequence, the noise being its difference to a reference
+ *
+ * @param data The sequence
+ * @param reference The reference sequence, of the same size
+ * @return The ratio of the energies of the reference and of the noise, in dB
+ */
+double
+signal_to_noise_ratio(const std::vector<std::complex<double>>& data, const std::vector<std::complex<double>>& reference);
+
+/**
+ * @brief Converts a complex number to double precision
+ *
+ * @param value The complex number
+ * @return The complex number in double precision
+ */
+template <typename T = Complex>
+std::complex<double>
+to_complex(const T& value)
+{
+    return {static_cast<double>(value.real()), static_cast<double>(value.imag())};
+}
+
 /**
  * @brief Find the peaks from the spectrum informed
  *
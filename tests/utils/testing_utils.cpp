@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <complex>
+#include <numbers>
 #include <vector>
 #include "fft_types.hpp"
 
@@ -31,4 +33,29 @@ sort_pairs(std::vector<std::pair<double, double>>& pairs_vector)
         return a.first > b.first;
     });
 }
+
+std::vector<std::complex<double>>
+reference_dft(const std::vector<std::complex<double>>& sequence)
+{
+    const auto                        sequence_size = sequence.size();
+    std::vector<std::complex<double>> spectrum(sequence_size);
+    for (std::size_t k = 0; k < sequence_size; ++k) {
+        for (std::size_t i = 0; i < sequence_size; ++i) {
+            spectrum[k] += sequence[i] * std::polar(1.0, 2 * std::numbers::pi * ((k * i) % sequence_size) / sequence_size);
+        }
+    }
+    return spectrum;
+}
+
+double
+signal_to_noise_ratio(const std::vector<std::complex<double>>& data, const std::vector<std::complex<double>>& reference)
+{
+    double signal_energy = 0;
+    double noise_energy  = 0;
+    for (std::size_t i = 0; i < reference.size(); ++i) {
+        signal_energy += std::norm(reference[i]);
+        noise_energy += std::norm(data[i] - reference[i]);
+    }
+    return 10 * std::log10(signal_energy / noise_energy);
+}
 }  // namespace fftemb::test_utils
\ No newline at end of file